@@ -0,0 +1,276 @@
+// fastpow.h
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+
+#pragma once
+
+#include <cfloat>   // For DBL_MAX, DBL_MIN
+#include <cmath>    // For std::fabs, std::floor, std::isfinite, std::pow, std::sqrt
+#include <cstdint>  // For std::uint64_t
+#include <cstring>  // For std::memcpy
+#include "mathconsts.h"
+
+namespace noise {
+
+    /// @addtogroup libnoise
+    /// @{
+
+    /// Maximum relative error of FastPow() and FastPower, compared with the exact
+    /// power, for results in the normal range of double.
+    ///
+    /// The error of FastPow() grows with the magnitude of exponent * log2(base);
+    /// this bound covers every result that neither overflows nor underflows.
+    /// Powers evaluated by a FastPower with an exponent that is a multiple of 1/8
+    /// are accurate to a few units in the last place.
+    inline constexpr double FAST_POW_MAX_RELATIVE_ERROR = 1.0e-12;
+
+    namespace detail {
+
+        /// Returns 2 raised to an integer power between -1022 and 1023.
+        [[nodiscard]] inline double Exp2Int(int n) noexcept {
+            const std::uint64_t bits = static_cast<std::uint64_t>(n + 1023) << 52;
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        /// Returns an approximation of log2(x) for a positive, normal, finite x.
+        ///
+        /// x is split into m * 2^e with m in [sqrt(1/2), sqrt(2)], and log2(m) is
+        /// evaluated from the series 2 / ln(2) * atanh(t), t = (m - 1) / (m + 1),
+        /// which converges quickly because |t| < 0.172. The batch FastPow() kernels
+        /// perform the same operations in the same order.
+        [[nodiscard]] inline double Log2Approx(double x) noexcept {
+            std::uint64_t bits;
+            std::memcpy(&bits, &x, sizeof(bits));
+            int exponent = static_cast<int>(bits >> 52) - 1023;
+            bits = (bits & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL;
+            double mantissa;
+            std::memcpy(&mantissa, &bits, sizeof(mantissa));
+            if (mantissa > SQRT_2) {
+                mantissa *= 0.5;
+                ++exponent;
+            }
+
+            // Estrin's scheme keeps the dependency chain short.
+            const double t = (mantissa - 1.0) / (mantissa + 1.0);
+            const double t2 = t * t;
+            const double t4 = t2 * t2;
+            const double t8 = t4 * t4;
+            const double c01 = 2.8853900817779268 + t2 * 0.9617966939259757;
+            const double c23 = 0.5770780163555853 + t2 * 0.41219858311113244;
+            const double c45 = 0.3205988979753252 + t2 * 0.2623081892525388;
+            const double c67 = 0.2219530832136867 + t2 * 0.19235933878519512;
+            const double c89 = 0.16972882833987804 + t2 * 0.15186263588304877;
+            const double series = (c01 + t4 * c23) + t8 * ((c45 + t4 * c67) + t8 * c89);
+            return static_cast<double>(exponent) + t * series;
+        }
+
+        /// Returns an approximation of 2^x for a finite x.
+        ///
+        /// x is split into n + f with an integer n and f in [-0.5, 0.5], and 2^f is
+        /// evaluated from its Taylor series. 2^n is applied as two factors so that
+        /// results that overflow or underflow become infinity or zero. The batch
+        /// FastPow() kernels perform the same operations in the same order.
+        [[nodiscard]] inline double Exp2Approx(double x) noexcept {
+            x = x < -1100.0 ? -1100.0 : (x > 1100.0 ? 1100.0 : x);
+            // Adding and subtracting 1.5 * 2^52 rounds to the nearest integer.
+            const double rounded = (x + 6755399441055744.0) - 6755399441055744.0;
+            const double f = x - rounded;
+            const double f2 = f * f;
+            const double f4 = f2 * f2;
+            const double f8 = f4 * f4;
+            const double c01 = 1.0 + f * 0.6931471805599453;
+            const double c23 = 0.2402265069591007 + f * 0.055504108664821576;
+            const double c45 = 0.009618129107628477 + f * 0.0013333558146428441;
+            const double c67 = 0.00015403530393381606 + f * 1.5252733804059838e-05;
+            const double c89 = 1.3215486790144305e-06 + f * 1.0178086009239696e-07;
+            const double c1011 = 7.054911620801121e-09 + f * 4.44553827187081e-10;
+            const double c1213 = 2.5678435993488196e-11 + f * 1.3691488853904124e-12;
+            const double series = ((c01 + f2 * c23) + f4 * (c45 + f2 * c67))
+                + f8 * ((c89 + f2 * c1011) + f4 * c1213);
+            const int n = static_cast<int>(rounded);
+            const int n0 = n / 2;
+            return series * Exp2Int(n0) * Exp2Int(n - n0);
+        }
+
+    } // namespace detail
+
+    /// Raises a value to a power, approximately.
+    ///
+    /// @param base The base.
+    /// @param exponent The exponent.
+    ///
+    /// @returns An approximation of std::pow(@a base, @a exponent), with a
+    /// relative error less than FAST_POW_MAX_RELATIVE_ERROR.
+    ///
+    /// The power is evaluated as 2^(exponent * log2(|base|)) using polynomial
+    /// approximations of log2 and exp2 that contain no branches other than the
+    /// rare special cases. Zero, infinite, subnormal and NaN bases, infinite and
+    /// zero exponents, and NaN exponents are handed to std::pow(), so they yield
+    /// the same special values. A negative base yields the sign of std::pow()
+    /// for an integer exponent and NaN otherwise.
+    [[nodiscard]] inline double FastPow(double base, double exponent) noexcept {
+        const double magnitude = std::fabs(base);
+        if (!(magnitude >= DBL_MIN && magnitude <= DBL_MAX) || !std::isfinite(exponent) || exponent == 0.0) {
+            return std::pow(base, exponent);
+        }
+
+        const double power = detail::Exp2Approx(exponent * detail::Log2Approx(magnitude));
+        if (base > 0.0) {
+            return power;
+        }
+        if (std::floor(exponent) != exponent) {
+            return std::pow(base, exponent);
+        }
+        const double half = exponent * 0.5;
+        return std::floor(half) != half ? -power : power;
+    }
+
+    /// Raises a batch of values to a batch of powers, approximately.
+    ///
+    /// @param base Array containing the bases.
+    /// @param exponent Array containing the exponents.
+    /// @param[out] out Array that receives the powers; it may be @a base or
+    /// @a exponent.
+    /// @param count The number of values.
+    ///
+    /// @pre Each array holds at least @a count elements.
+    ///
+    /// Each output value is identical to the value that the single-value
+    /// FastPow() returns for the same base and exponent. On x86 processors that
+    /// support AVX2, four values are evaluated per instruction; the instruction
+    /// set is selected at run time.
+    void FastPow(const double* base, const double* exponent, double* out, int count) noexcept;
+
+    /// Raises a batch of values to the same power, approximately.
+    ///
+    /// @see FastPow(const double*, const double*, double*, int)
+    void FastPow(const double* base, double exponent, double* out, int count) noexcept;
+
+    /// An exponent prepared for raising many values to the same power.
+    ///
+    /// An exponent that is a multiple of 1/8 with a magnitude of at most 64 (such
+    /// as 2, 1.5 or 1.375) is decomposed into an integer power, evaluated by
+    /// repeated squaring, and up to three nested square roots; the result is
+    /// accurate to a few units in the last place. Any other exponent is evaluated
+    /// by FastPow().
+    class FastPower {
+    public:
+        /// Constructor.
+        ///
+        /// @param exponent The exponent.
+        explicit FastPower(double exponent = 1.0) noexcept
+            : m_exponent(exponent),
+            m_isDecomposed(false),
+            m_isNegative(exponent < 0.0),
+            m_integerPower(0),
+            m_rootMask(0),
+            m_rootCount(0) {
+            const double magnitude = std::fabs(exponent);
+            const double eighths = magnitude * 8.0;
+            if (magnitude <= 64.0 && std::floor(eighths) == eighths) {
+                const int eighthCount = static_cast<int>(eighths);
+                m_isDecomposed = true;
+                m_integerPower = eighthCount / 8;
+                // Bit k selects the root 2^-(k + 1).
+                m_rootMask = ((eighthCount & 4) >> 2) | (eighthCount & 2) | ((eighthCount & 1) << 2);
+                m_rootCount = (eighthCount & 1) ? 3 : (eighthCount & 2) ? 2 : (eighthCount & 4) ? 1 : 0;
+            }
+        }
+
+        /// Returns the exponent.
+        ///
+        /// @returns The exponent.
+        [[nodiscard]] inline double GetExponent() const noexcept {
+            return m_exponent;
+        }
+
+        /// Determines if the exponent is evaluated by repeated squaring and
+        /// square roots instead of FastPow().
+        ///
+        /// @returns True if the exponent is a multiple of 1/8 with a magnitude of
+        /// at most 64, false otherwise.
+        [[nodiscard]] inline bool IsDecomposed() const noexcept {
+            return m_isDecomposed;
+        }
+
+        /// Raises a value to the power.
+        ///
+        /// @param base The base.
+        ///
+        /// @returns An approximation of std::pow(@a base, GetExponent()), with a
+        /// relative error less than FAST_POW_MAX_RELATIVE_ERROR. The sign of a
+        /// zero result may differ from the sign that std::pow() returns.
+        [[nodiscard]] inline double operator()(double base) const noexcept {
+            if (!m_isDecomposed) {
+                return FastPow(base, m_exponent);
+            }
+
+            double power = 1.0;
+            double square = base;
+            for (int n = m_integerPower; n != 0; n >>= 1) {
+                if (n & 1) {
+                    power *= square;
+                }
+                square *= square;
+            }
+            double root = base;
+            for (int k = 0; k < m_rootCount; ++k) {
+                root = std::sqrt(root);
+                if (m_rootMask & (1 << k)) {
+                    power *= root;
+                }
+            }
+            return m_isNegative ? 1.0 / power : power;
+        }
+
+        /// Raises a batch of values to the power.
+        ///
+        /// @param base Array containing the bases.
+        /// @param[out] out Array that receives the powers; it may be @a base.
+        /// @param count The number of values.
+        ///
+        /// Each output value is identical to the value that operator()(double)
+        /// returns for the same base.
+        inline void operator()(const double* base, double* out, int count) const noexcept {
+            if (!m_isDecomposed) {
+                FastPow(base, m_exponent, out, count);
+                return;
+            }
+            for (int i = 0; i < count; ++i) {
+                out[i] = (*this)(base[i]);
+            }
+        }
+
+    private:
+        /// The exponent.
+        double m_exponent;
+
+        /// Determines if the exponent is decomposed into an integer power and roots.
+        bool m_isDecomposed;
+
+        /// Determines if the decomposed exponent is negative.
+        bool m_isNegative;
+
+        /// Integer part of the magnitude of the decomposed exponent.
+        int m_integerPower;
+
+        /// Roots of the decomposed exponent; bit k selects the root 2^-(k + 1).
+        int m_rootMask;
+
+        /// Number of nested square roots to take.
+        int m_rootCount;
+    };
+
+    /// @}
+
+} // namespace noise
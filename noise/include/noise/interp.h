@@ -79,6 +79,38 @@ namespace noise {
         return (1.0 - a) * n0 + a * n1;
     }
 
+    /// Performs linear interpolation between two single-precision values.
+    ///
+    /// @see LinearInterp(double, double, double)
+    [[nodiscard]] inline constexpr float LinearInterp(float n0, float n1, float a) noexcept {
+        return (1.0f - a) * n0 + a * n1;
+    }
+
+    /// Performs linear interpolation between two values, returning a value
+    /// unchanged if the alpha value gives it the full weight.
+    ///
+    /// @param n0 The first value.
+    /// @param n1 The second value.
+    /// @param a The alpha value, typically in the range [0, 1].
+    ///
+    /// @returns @a n0 if the alpha value is 0.0, @a n1 if the alpha value is
+    /// 1.0, and LinearInterp(n0, n1, a) otherwise.
+    ///
+    /// The value with the weight 0.0 does not affect the result (LinearInterp()
+    /// adds it times zero, which can change the sign of a zero result), so a
+    /// caller that knows the alpha value first can skip computing that value.
+    [[nodiscard]] inline constexpr double SelectInterp(double n0, double n1, double a) noexcept {
+        return (a == 0.0) ? n0 : ((a == 1.0) ? n1 : LinearInterp(n0, n1, a));
+    }
+
+    /// Performs linear interpolation between two single-precision values,
+    /// returning a value unchanged if the alpha value gives it the full weight.
+    ///
+    /// @see SelectInterp(double, double, double)
+    [[nodiscard]] inline constexpr float SelectInterp(float n0, float n1, float a) noexcept {
+        return (a == 0.0f) ? n0 : ((a == 1.0f) ? n1 : LinearInterp(n0, n1, a));
+    }
+
     /// Maps a value onto a cubic S-curve.
     ///
     /// @param a The value to map, typically in the range [0, 1].
@@ -91,6 +123,13 @@ namespace noise {
         return a * a * (3.0 - 2.0 * a);
     }
 
+    /// Maps a single-precision value onto a cubic S-curve.
+    ///
+    /// @see SCurve3(double)
+    [[nodiscard]] inline constexpr float SCurve3(float a) noexcept {
+        return a * a * (3.0f - 2.0f * a);
+    }
+
     /// Maps a value onto a quintic S-curve.
     ///
     /// @param a The value to map, typically in the range [0, 1].
@@ -107,4 +146,15 @@ namespace noise {
         return 6.0 * a5 - 15.0 * a4 + 10.0 * a3;
     }
 
+    /// Maps a single-precision value onto a quintic S-curve.
+    ///
+    /// @see SCurve5(double)
+    [[nodiscard]] inline constexpr float SCurve5(float a) noexcept {
+        const float a2 = a * a;
+        const float a3 = a2 * a;
+        const float a4 = a3 * a;
+        const float a5 = a4 * a;
+        return 6.0f * a5 - 15.0f * a4 + 10.0f * a3;
+    }
+
 } // namespace noise
\ No newline at end of file
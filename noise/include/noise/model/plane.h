@@ -46,6 +46,11 @@ namespace noise {
         /// - terrain height maps for local areas
         ///
         /// This plane extends infinitely in both directions.
+        ///
+        /// The Perlin, Billow, and RidgedMulti noise modules recognize input values
+        /// on this plane and evaluate them with the cheaper two-dimensional noise
+        /// function (see noise::GradientCoherentNoise2D()), which produces the same
+        /// output values.
         class Plane {
         public:
             /// Constructor.
@@ -27,8 +27,9 @@
 
 #pragma once
 
-#include <cassert> // For assert
-#include <cmath>   // For std::abs
+#include <algorithm> // For std::max
+#include <cassert>   // For assert
+#include <cmath>     // For std::abs
 #include "modulebase.h"
 
 namespace noise {
@@ -45,6 +46,11 @@ namespace noise {
             /// Constructor.
             Abs() noexcept : Module(GetSourceModuleCount()) {}
 
+            /// @see Module::Clone()
+            [[nodiscard]] std::unique_ptr<Module> Clone() const override {
+                return CloneAs<Abs>();
+            }
+
             /// Returns the number of source modules required by this noise module.
             ///
             /// @returns Always 1, as this module requires exactly one source module.
@@ -52,6 +58,23 @@ namespace noise {
                 return 1;
             }
 
+            /// Returns an interval that contains every output value of this noise module.
+            ///
+            /// @returns The output range of the source module, with negative values
+            /// reflected onto positive values.
+            ///
+            /// @see Module::GetValueRange()
+            [[nodiscard]] inline ValueRange GetValueRange() const override {
+                const ValueRange source = GetSourceModule(0).GetValueRange();
+                if (source.lowerBound >= 0.0) {
+                    return source;
+                }
+                if (source.upperBound <= 0.0) {
+                    return { -source.upperBound, -source.lowerBound };
+                }
+                return { 0.0, std::max(-source.lowerBound, source.upperBound) };
+            }
+
             /// Generates the output value by taking the absolute value of the source module's output.
             ///
             /// @param x The x-coordinate of the input value.
@@ -61,8 +84,52 @@ namespace noise {
             /// @returns The absolute value of the source module's output.
             /// @pre The source module at index 0 has been set.
             inline double GetValue(double x, double y, double z) const noexcept override {
+                return GetValue(EvalContext(), x, y, z);
+            }
+
+            /// @see Module::GetValue(const EvalContext&, double, double, double)
+            inline double GetValue(const EvalContext& context, double x, double y, double z) const noexcept override {
                 assert(m_sourceModules[0] != nullptr && "Source module must be set before calling GetValue");
-                return std::abs(m_sourceModules[0]->GetValue(x, y, z));
+                return std::abs(m_sourceModules[0]->GetValue(context, x, y, z));
+            }
+
+            /// Generates the absolute values of the source module's output for a batch
+            /// of input values.
+            ///
+            /// @see Module::GetValues()
+            inline void GetValues(const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(EvalContext(), x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(EvalContext(), x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const EvalContext& context, const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(context, x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const EvalContext& context, const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(context, x, y, z, out, count);
+            }
+
+        private:
+            /// Implements the overloads of GetValues(); Real is double or float.
+            template <typename Real>
+            void GetValuesImpl(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+                Real* out, int count) const noexcept {
+                assert(m_sourceModules[0] != nullptr && "Source module must be set before calling GetValues");
+                m_sourceModules[0]->GetValues(context, x, y, z, out, count);
+                for (int i = 0; i < count; ++i) {
+                    out[i] = std::abs(out[i]);
+                }
             }
         };
 
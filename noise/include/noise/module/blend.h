@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <algorithm> // For std::min
 #include <cassert>  // For assert
 #include "../interp.h"
 #include "modulebase.h"
@@ -49,11 +50,23 @@ namespace noise {
         ///
         /// The control module's output, ranging from -1.0 to +1.0, is scaled to 0.0 to
         /// 1.0 and used as the interpolation factor between the two source modules.
+        ///
+        /// The control module is evaluated first. Where its output value is exactly
+        /// -1.0 or +1.0 (e.g., a clamped control module), this module outputs the
+        /// value from source module 0 or 1 unchanged and does not evaluate the other
+        /// source module. GetValues() evaluates each source module once per block of
+        /// up to GATHER_BLOCK_SIZE input values, for the input values in the block
+        /// that give it a nonzero weight.
         class Blend : public Module {
         public:
             /// Constructor.
             Blend() noexcept : Module(GetSourceModuleCount()) {}
 
+            /// @see Module::Clone()
+            [[nodiscard]] std::unique_ptr<Module> Clone() const override {
+                return CloneAs<Blend>();
+            }
+
             /// Returns the number of source modules required by this noise module.
             ///
             /// @returns Always 3, as this module requires three source modules.
@@ -61,6 +74,26 @@ namespace noise {
                 return 3;
             }
 
+            /// Returns an interval that contains every output value of this noise module.
+            ///
+            /// @returns The union of the output ranges of the source modules if the
+            /// control module stays within -1.0 to +1.0; otherwise, the range of the
+            /// extrapolated values.
+            ///
+            /// @see Module::GetValueRange()
+            [[nodiscard]] inline ValueRange GetValueRange() const override {
+                const ValueRange source0 = GetSourceModule(0).GetValueRange();
+                const ValueRange source1 = GetSourceModule(1).GetValueRange();
+                const ValueRange control = GetSourceModule(2).GetValueRange();
+                const ValueRange alpha = { (control.lowerBound + 1.0) / 2.0, (control.upperBound + 1.0) / 2.0 };
+                if (alpha.lowerBound >= 0.0 && alpha.upperBound <= 1.0) {
+                    return source0.Union(source1);
+                }
+                const ValueRange weighted0 = ValueRange{ 1.0 - alpha.upperBound, 1.0 - alpha.lowerBound }.Product(source0);
+                const ValueRange weighted1 = alpha.Product(source1);
+                return { weighted0.lowerBound + weighted1.lowerBound, weighted0.upperBound + weighted1.upperBound };
+            }
+
             /// Returns the blended output value from the two source modules based on
             /// the control module's output.
             ///
@@ -71,16 +104,56 @@ namespace noise {
             /// @returns The blended output value.
             /// @pre All source modules (indices 0, 1, and 2) have been set.
             inline double GetValue(double x, double y, double z) const noexcept override {
+                return GetValue(EvalContext(), x, y, z);
+            }
+
+            /// @see Module::GetValue(const EvalContext&, double, double, double)
+            inline double GetValue(const EvalContext& context, double x, double y, double z) const noexcept override {
                 assert(m_sourceModules[0] != nullptr && "Source module 0 must be set before calling GetValue");
                 assert(m_sourceModules[1] != nullptr && "Source module 1 must be set before calling GetValue");
                 assert(m_sourceModules[2] != nullptr && "Control module (source module 2) must be set before calling GetValue");
 
-                const double v0 = m_sourceModules[0]->GetValue(x, y, z);
-                const double v1 = m_sourceModules[1]->GetValue(x, y, z);
-                const double alpha = (m_sourceModules[2]->GetValue(x, y, z) + 1.0) / 2.0;
+                const double alpha = (m_sourceModules[2]->GetValue(context, x, y, z) + 1.0) / 2.0;
+                if (alpha == 0.0) {
+                    return m_sourceModules[0]->GetValue(context, x, y, z);
+                } else if (alpha == 1.0) {
+                    return m_sourceModules[1]->GetValue(context, x, y, z);
+                }
+                const double v0 = m_sourceModules[0]->GetValue(context, x, y, z);
+                const double v1 = m_sourceModules[1]->GetValue(context, x, y, z);
                 return LinearInterp(v0, v1, alpha);
             }
 
+            /// Returns the blended output values from the two source modules for a
+            /// batch of input values.
+            ///
+            /// Each source module is evaluated only for the input values that give it
+            /// a nonzero weight (see Select::GetValues() for shared source modules).
+            ///
+            /// @see Module::GetValues()
+            inline void GetValues(const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(EvalContext(), x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(EvalContext(), x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const EvalContext& context, const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(context, x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const EvalContext& context, const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(context, x, y, z, out, count);
+            }
+
             /// Sets the control module.
             ///
             /// @param controlModule The control module.
@@ -93,6 +166,52 @@ namespace noise {
             inline void SetControlModule(const Module& controlModule) noexcept {
                 assert(m_sourceModules.size() >= 3);
                 m_sourceModules[2] = &controlModule;
+                InvalidateValueRanges();
+            }
+
+        private:
+            /// Implements the overloads of GetValues(); Real is double or float.
+            template <typename Real>
+            void GetValuesImpl(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+                Real* out, int count) const noexcept {
+                assert(m_sourceModules[0] != nullptr && "Source module 0 must be set before calling GetValues");
+                assert(m_sourceModules[1] != nullptr && "Source module 1 must be set before calling GetValues");
+                assert(m_sourceModules[2] != nullptr && "Control module (source module 2) must be set before calling GetValues");
+
+                // For each block of input values, evaluate the control module first,
+                // then evaluate each source module once for the input values of the
+                // block that give it a nonzero weight.
+                Real alphas[GATHER_BLOCK_SIZE];
+                Real values1[GATHER_BLOCK_SIZE];
+                int indices[GATHER_BLOCK_SIZE];
+                for (int start = 0; start < count; start += GATHER_BLOCK_SIZE) {
+                    const int blockCount = std::min(GATHER_BLOCK_SIZE, count - start);
+                    const Real* blockX = x + start;
+                    const Real* blockY = y + start;
+                    const Real* blockZ = z + start;
+                    Real* blockOut = out + start;
+                    m_sourceModules[2]->GetValues(context, blockX, blockY, blockZ, alphas, blockCount);
+                    for (int i = 0; i < blockCount; ++i) {
+                        alphas[i] = (alphas[i] + Real(1.0)) / Real(2.0);
+                    }
+
+                    Real* values[2] = { blockOut, values1 };
+                    for (int source = 0; source < 2; ++source) {
+                        const Real zeroWeightAlpha = (source == 0) ? Real(1.0) : Real(0.0);
+                        int indexCount = 0;
+                        for (int i = 0; i < blockCount; ++i) {
+                            if (alphas[i] != zeroWeightAlpha) {
+                                indices[indexCount++] = i;
+                            }
+                        }
+                        GetValuesAt(*m_sourceModules[source], context, indices, indexCount,
+                            blockX, blockY, blockZ, values[source], blockCount);
+                    }
+
+                    for (int i = 0; i < blockCount; ++i) {
+                        blockOut[i] = SelectInterp(blockOut[i], values1[i], alphas[i]);
+                    }
+                }
             }
         };
 
@@ -16,19 +16,11 @@
 // off every 'zig').
 //
 // Updated for C++17 compatibility by TEK Nemesis and Grok on April 23, 2025:
-// - Replaced include guard with #pragma once.
-// - Added noexcept to member functions that do not throw exceptions.
-// - Added override to virtual functions for clarity.
-// - Moved GetValue and SetSourceModule to header as inline to improve efficiency.
-// - Used nullptr instead of NULL for modern C++ style.
-// - Used member initializer list in constructor for clarity.
-// - Changed m_isCached type from double to bool to match its usage.
-// - Improved documentation with consistent formatting.
-// - Removed redundant Doxygen group tags.
-
-#pragma once
-
-#include <cassert> // For assert
+// - Replaced include guard with #pragma once
+
+#include <cassert>   // For assert
+#include <cstdint>   // For std::uint64_t
+#include <vector>    // For std::vector
 #include "modulebase.h"
 
 namespace noise {
@@ -46,7 +38,15 @@ namespace noise {
         /// Caching is useful when a source module is used by multiple noise modules, preventing
         /// redundant calculations of the same output value for the same input coordinates.
         ///
-        /// Setting a new source module via SetSourceModule() invalidates the cache.
+        /// The cached values are stored per thread, so several threads can evaluate a graph
+        /// that contains this module at the same time (e.g., the multithreaded noise-map
+        /// builders). Each thread only hits on the input values that it evaluated itself.
+        /// Each thread keeps a fixed number of cache slots; cache modules whose slots
+        /// collide evict each other, which costs a recomputation but never returns a wrong
+        /// value.
+        ///
+        /// Setting a new source module via SetSourceModule() invalidates the cache in all
+        /// threads.
         ///
         /// This noise module requires one source module.
         class Cache : public Module {
@@ -54,11 +54,28 @@ namespace noise {
             /// Constructor.
             Cache() noexcept
                 : Module(GetSourceModuleCount()),
-                m_isCached(false),
-                m_cachedValue(0.0),
-                m_xCache(0.0),
-                m_yCache(0.0),
-                m_zCache(0.0) {
+                m_cacheId(NewCacheId()) {
+            }
+
+            /// Copy constructor.
+            ///
+            /// The copy has its own cached values, so it never returns a value that
+            /// was cached by the other cache module.
+            Cache(const Cache& other) noexcept
+                : Module(other),
+                m_cacheId(NewCacheId()) {
+            }
+
+            /// Copy assignment operator; invalidates the cache.
+            Cache& operator=(const Cache& other) noexcept {
+                Module::operator=(other);
+                m_cacheId = NewCacheId();
+                return *this;
+            }
+
+            /// @see Module::Clone()
+            [[nodiscard]] std::unique_ptr<Module> Clone() const override {
+                return CloneAs<Cache>();
             }
 
             /// Returns the number of source modules required by this noise module.
@@ -68,8 +85,17 @@ namespace noise {
                 return 1;
             }
 
+            /// Returns an interval that contains every output value of this noise module.
+            ///
+            /// @returns The output range of the source module.
+            ///
+            /// @see Module::GetValueRange()
+            [[nodiscard]] inline ValueRange GetValueRange() const override {
+                return GetSourceModule(0).GetValueRange();
+            }
+
             /// Generates the output value for the given input coordinates, using the cached
-            /// value if the coordinates match the previous call.
+            /// value if the coordinates match the previous call from the calling thread.
             ///
             /// @param x The x-coordinate of the input value.
             /// @param y The y-coordinate of the input value.
@@ -78,48 +104,159 @@ namespace noise {
             /// @returns The output value from the source module, either cached or newly computed.
             /// @pre The source module (index 0) has been set.
             inline double GetValue(double x, double y, double z) const noexcept override {
+                return GetValue(EvalContext(), x, y, z);
+            }
+
+            /// Returns the output value from the source module, using the cached
+            /// value if the coordinates and the evaluation context (see EvalContext)
+            /// match the previous call from the calling thread.
+            ///
+            /// @see Module::GetValue(const EvalContext&, double, double, double)
+            inline double GetValue(const EvalContext& context, double x, double y, double z) const noexcept override {
                 assert(m_sourceModules[0] != nullptr && "Source module must be set before calling GetValue");
 
-                if (m_isCached && x == m_xCache && y == m_yCache && z == m_zCache) {
-                    return m_cachedValue;
+                const std::uint64_t cacheId = m_cacheId;
+                PointCache& cache = GetPointCache(cacheId);
+                if (cache.cacheId == cacheId && x == cache.x && y == cache.y && z == cache.z
+                    && cache.context == context) {
+                    if (context.stats != nullptr) {
+                        ++context.stats->cacheHits;
+                    }
+                    return cache.value;
+                }
+                if (context.stats != nullptr) {
+                    ++context.stats->cacheMisses;
                 }
 
-                m_cachedValue = m_sourceModules[0]->GetValue(x, y, z);
-                m_xCache = x;
-                m_yCache = y;
-                m_zCache = z;
-                m_isCached = true;
-                return m_cachedValue;
+                // The source module may contain other cache modules that share this
+                // slot, so the slot is written only after the source value is known.
+                const double value = m_sourceModules[0]->GetValue(context, x, y, z);
+                cache.cacheId = cacheId;
+                cache.x = x;
+                cache.y = y;
+                cache.z = z;
+                cache.context = context;
+                cache.value = value;
+                return value;
             }
 
+            /// Generates the output values for a batch of input values, using the
+            /// cached value for each input value that the calling thread recently
+            /// evaluated with the same evaluation context (see EvalContext).
+            ///
+            /// When several noise modules share this module as a source, each of them
+            /// requests the input values it needs in turn (e.g., Select requests only
+            /// the input values for which it selects this module). Only the input
+            /// values that no earlier request evaluated are passed to the source
+            /// module, in one batch. The cached values are kept until the input values
+            /// of the following batches no longer fit beside them. The hash table of
+            /// a thread's cache slot holds a bounded number of values, so a very
+            /// large batch is processed in several parts.
+            ///
+            /// @see Module::GetValues()
+            void GetValues(const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override;
+
+            /// @see Module::GetValues()
+            void GetValues(const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override;
+
+            /// @see Module::GetValues()
+            void GetValues(const EvalContext& context, const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override;
+
+            /// @see Module::GetValues()
+            void GetValues(const EvalContext& context, const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override;
+
             /// Sets the source module at the specified index and invalidates the cache.
             ///
             /// @param index The index value (must be 0 for this module).
             /// @param sourceModule The source module to set.
             ///
-            /// This method invalidates the cache by resetting the cached state.
+            /// This method invalidates the cached values of all threads.
             inline void SetSourceModule(int index, const Module& sourceModule) override {
                 Module::SetSourceModule(index, sourceModule);
-                m_isCached = false;
+                m_cacheId = NewCacheId();
             }
 
         protected:
-            /// The cached output value from the last call to GetValue.
-            mutable double m_cachedValue;
+            /// The input value and output value of the last call to GetValue() in one
+            /// cache slot of a thread.
+            struct PointCache {
+                /// Identifier of the cache module that owns the slot, or 0 if unused.
+                std::uint64_t cacheId = 0;
+
+                /// The coordinates of the cached input value.
+                double x = 0.0, y = 0.0, z = 0.0;
+
+                /// The evaluation context of the cached input value.
+                EvalContext context;
+
+                /// The cached output value.
+                double value = 0.0;
+            };
+
+            /// The input values and output values of recent batches of a given
+            /// precision in one cache slot of a thread, in an open-addressing hash
+            /// table keyed by the exact coordinates of the input values.
+            template <typename Real>
+            struct BatchCache {
+                /// One input value and its output value.
+                struct Entry {
+                    /// The coordinates of the input value.
+                    Real x, y, z;
+
+                    /// The output value.
+                    Real value;
+
+                    /// The entry is in use if this equals BatchCache::generation.
+                    std::uint32_t generation = 0;
+                };
+
+                /// Identifier of the cache module that owns the slot, or 0 if unused.
+                std::uint64_t cacheId = 0;
+
+                /// The evaluation context of the stored values.
+                EvalContext context;
+
+                /// The hash table; its size is zero or a power of two.
+                std::vector<Entry> entries;
+
+                /// The generation of the entries in use. Incrementing it empties the
+                /// table without touching the entries.
+                std::uint32_t generation = 1;
+
+                /// The number of entries in use.
+                size_t size = 0;
+            };
+
+            /// Returns a new identifier that no other cache state has used.
+            static std::uint64_t NewCacheId() noexcept;
+
+            /// Returns the calling thread's point-cache slot for a cache identifier.
+            static PointCache& GetPointCache(std::uint64_t cacheId) noexcept;
 
-            /// Indicates whether a cached output value is stored.
-            mutable bool m_isCached;
+            /// Returns the calling thread's batch-cache slot for a cache identifier.
+            template <typename Real>
+            static BatchCache<Real>& GetBatchCache(std::uint64_t cacheId) noexcept;
 
-            /// x-coordinate of the cached input value.
-            mutable double m_xCache;
+            /// Assigns a batch-cache slot of the calling thread to this module and
+            /// empties it, making room for the input values of a batch of the given
+            /// size.
+            template <typename Real>
+            void ClearBatchCache(BatchCache<Real>& cache, const EvalContext& context, int count) const noexcept;
 
-            /// y-coordinate of the cached input value.
-            mutable double m_yCache;
+            /// Implements the overloads of GetValues(); Real is double or float.
+            template <typename Real>
+            void GetValuesImpl(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+                Real* out, int count) const noexcept;
 
-            /// z-coordinate of the cached input value.
-            mutable double m_zCache;
+            /// Identifies the cached values of this module in the per-thread cache
+            /// slots. A new identifier is assigned whenever the cache is invalidated.
+            std::uint64_t m_cacheId;
         };
 
     } // namespace module
 
-} // namespace noise
\ No newline at end of file
+} // namespace noise
@@ -50,6 +50,11 @@ namespace noise {
             /// Constructor.
             Checkerboard() noexcept : Module(GetSourceModuleCount()) {}
 
+            /// @see Module::Clone()
+            [[nodiscard]] std::unique_ptr<Module> Clone() const override {
+                return CloneAs<Checkerboard>();
+            }
+
             /// Returns the number of source modules required by this noise module.
             ///
             /// @returns Always 0, as this module does not require any source modules.
@@ -57,6 +62,15 @@ namespace noise {
                 return 0;
             }
 
+            /// Returns an interval that contains every output value of this noise module.
+            ///
+            /// @returns Always -1.0 to +1.0.
+            ///
+            /// @see Module::GetValueRange()
+            [[nodiscard]] inline ValueRange GetValueRange() const override {
+                return { -1.0, 1.0 };
+            }
+
             /// Generates the output value for the given input coordinates.
             ///
             /// @param x The x-coordinate of the input value.
@@ -76,6 +90,33 @@ namespace noise {
                 const int iz = static_cast<int>(std::floor(MakeInt32Range(z)));
                 return (ix & 1 ^ iy & 1 ^ iz & 1) ? -1.0 : 1.0;
             }
+
+            /// Generates the checkerboard values for a batch of input values.
+            ///
+            /// @see Module::GetValues()
+            inline void GetValues(const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(x, y, z, out, count);
+            }
+
+            using Module::GetValue;
+            using Module::GetValues;
+
+        private:
+            /// Implements both overloads of GetValues(); Real is double or float.
+            template <typename Real>
+            void GetValuesImpl(const Real* x, const Real* y, const Real* z,
+                Real* out, int count) const noexcept {
+                for (int i = 0; i < count; ++i) {
+                    out[i] = static_cast<Real>(Checkerboard::GetValue(x[i], y[i], z[i]));
+                }
+            }
         };
 
     } // namespace module
@@ -30,7 +30,7 @@
 
 #pragma once
 
-#include <algorithm>  // For std::clamp
+#include <algorithm>  // For std::clamp, std::fill
 #include <cassert>    // For assert
 #include "modulebase.h"
 
@@ -52,6 +52,12 @@ namespace module {
     /// range defined by the lower and upper bounds, set via SetBounds().
     ///
     /// This noise module requires one source module.
+    ///
+    /// If the output range of the source module (see GetValueRange()) lies
+    /// entirely below or above the clamping range, GetValues() outputs the
+    /// nearer bound without evaluating the source module. The range is checked
+    /// on the first batch and again only after a change to a noise module (see
+    /// Module::InvalidateValueRanges()).
     class Clamp : public Module {
     public:
         /// Constructor.
@@ -60,6 +66,11 @@ namespace module {
               m_lowerBound(DEFAULT_CLAMP_LOWER_BOUND),
               m_upperBound(DEFAULT_CLAMP_UPPER_BOUND) {}
 
+        /// @see Module::Clone()
+        [[nodiscard]] std::unique_ptr<Module> Clone() const override {
+            return CloneAs<Clamp>();
+        }
+
         /// Returns the number of source modules required by this noise module.
         ///
         /// @returns Always 1, as this module requires one source module.
@@ -67,6 +78,18 @@ namespace module {
             return 1;
         }
 
+        /// Returns an interval that contains every output value of this noise module.
+        ///
+        /// @returns The output range of the source module, clamped to the bounds of
+        /// this module.
+        ///
+        /// @see Module::GetValueRange()
+        [[nodiscard]] inline ValueRange GetValueRange() const override {
+            const ValueRange source = GetSourceModule(0).GetValueRange();
+            return { std::clamp(source.lowerBound, m_lowerBound, m_upperBound),
+                std::clamp(source.upperBound, m_lowerBound, m_upperBound) };
+        }
+
         /// Returns the clamped output value from the source module.
         ///
         /// @param x The x-coordinate of the input value.
@@ -76,8 +99,40 @@ namespace module {
         /// @returns The clamped output value.
         /// @pre The source module (index 0) has been set.
         inline double GetValue(double x, double y, double z) const noexcept override {
+            return GetValue(EvalContext(), x, y, z);
+        }
+
+        /// @see Module::GetValue(const EvalContext&, double, double, double)
+        inline double GetValue(const EvalContext& context, double x, double y, double z) const noexcept override {
             assert(m_sourceModules[0] != nullptr && "Source module must be set before calling GetValue");
-            return std::clamp(m_sourceModules[0]->GetValue(x, y, z), m_lowerBound, m_upperBound);
+            return std::clamp(m_sourceModules[0]->GetValue(context, x, y, z), m_lowerBound, m_upperBound);
+        }
+
+        /// Generates the clamped output values from the source module for a batch
+        /// of input values.
+        ///
+        /// @see Module::GetValues()
+        inline void GetValues(const double* x, const double* y, const double* z,
+            double* out, int count) const noexcept override {
+            GetValuesImpl(EvalContext(), x, y, z, out, count);
+        }
+
+        /// @see Module::GetValues()
+        inline void GetValues(const float* x, const float* y, const float* z,
+            float* out, int count) const noexcept override {
+            GetValuesImpl(EvalContext(), x, y, z, out, count);
+        }
+
+        /// @see Module::GetValues()
+        inline void GetValues(const EvalContext& context, const double* x, const double* y, const double* z,
+            double* out, int count) const noexcept override {
+            GetValuesImpl(context, x, y, z, out, count);
+        }
+
+        /// @see Module::GetValues()
+        inline void GetValues(const EvalContext& context, const float* x, const float* y, const float* z,
+            float* out, int count) const noexcept override {
+            GetValuesImpl(context, x, y, z, out, count);
         }
 
         /// Returns the lower bound of the clamping range.
@@ -106,14 +161,65 @@ namespace module {
             }
             m_lowerBound = lowerBound;
             m_upperBound = upperBound;
+            InvalidateValueRanges();
         }
 
     protected:
+        /// CompiledGraph reads the internal state of this module when it
+        /// flattens a graph that contains it.
+        friend class CompiledGraph;
+
+        /// Implements the overloads of GetValues(); Real is double or float.
+        template <typename Real>
+        void GetValuesImpl(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+            Real* out, int count) const noexcept {
+            assert(m_sourceModules[0] != nullptr && "Source module must be set before calling GetValues");
+            const int clampedBound = m_clampedBound.Get([this] {
+                double boundValue;
+                return IsClampedToBound(boundValue) ? (boundValue == m_lowerBound ? 0 : 1) : -1;
+            });
+            if (clampedBound >= 0) {
+                std::fill(out, out + count, static_cast<Real>(clampedBound == 0 ? m_lowerBound : m_upperBound));
+                return;
+            }
+            const Real lowerBound = static_cast<Real>(m_lowerBound);
+            const Real upperBound = static_cast<Real>(m_upperBound);
+            m_sourceModules[0]->GetValues(context, x, y, z, out, count);
+            for (int i = 0; i < count; ++i) {
+                out[i] = std::clamp(out[i], lowerBound, upperBound);
+            }
+        }
+
+        /// Determines if every output value of the source module lies outside
+        /// the clamping range on the same side, according to its output range.
+        ///
+        /// @param[out] boundValue Receives the bound that GetValue() returns at
+        /// every input value if so.
+        ///
+        /// @returns True if every output value is clamped to the same bound.
+        [[nodiscard]] bool IsClampedToBound(double& boundValue) const {
+            const ValueRange source = m_sourceModules[0]->GetValueRange();
+            if (source.upperBound < m_lowerBound) {
+                boundValue = m_lowerBound;
+                return true;
+            }
+            if (source.lowerBound > m_upperBound) {
+                boundValue = m_upperBound;
+                return true;
+            }
+            return false;
+        }
+
         /// Lower bound of the clamping range.
         double m_lowerBound;
 
         /// Upper bound of the clamping range.
         double m_upperBound;
+
+        /// The bound that every output value is clamped to (0 for the lower
+        /// bound, 1 for the upper bound), according to the output range of the
+        /// source module (see IsClampedToBound()).
+        RangeDecision m_clampedBound;
     };
 
 } // namespace module
@@ -0,0 +1,372 @@
+// compiledgraph.h
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+
+#pragma once
+
+#include <array>    // For std::array
+#include <memory>   // For std::shared_ptr
+#include <vector>   // For std::vector
+#include "modulebase.h"
+
+namespace noise {
+
+    namespace module {
+
+        /// A noise module that evaluates a flattened copy of a noise-module graph.
+        ///
+        /// Compile() walks the graph of source modules below a root module once,
+        /// sorts the distinct modules topologically, and emits a linear program of
+        /// instructions. Each instruction reads and writes register slots that hold
+        /// a block of values (or coordinates). GetValues() runs the program over
+        /// blocks of input values in a single loop, so evaluating the graph no
+        /// longer follows source-module pointers recursively.
+        ///
+        /// Common subexpressions are evaluated once per input value: a module that
+        /// is shared by several other modules (with or without a Cache module in
+        /// between), and flattened modules of the same type with the same
+        /// parameters and source modules, share one register. Cache modules are
+        /// therefore unnecessary in a compiled graph.
+        ///
+        /// The output values are identical to the output values of the root module.
+        /// All built-in modules are flattened; a Cache module becomes a reference
+        /// to its source module's register. The selectable source modules of a
+        /// Select module and the blended source modules of a Blend module are
+        /// the exception unless other modules also use them: as in the Select and
+        /// Blend modules themselves, each is evaluated only at the input values
+        /// that need it. Such a source module is compiled into a sub-program of
+        /// its own if none of the modules below it is used elsewhere in the graph;
+        /// otherwise it stays interpreted (its GetValues() method is called), so
+        /// that its Cache modules keep sharing output values with the rest of the
+        /// graph. A generator module, or a custom module type that the compiler
+        /// does not recognize, is evaluated by calling its own GetValues() method.
+        ///
+        /// The compiler also simplifies the graph without changing any output value:
+        /// operations whose source values are all constant are evaluated once at
+        /// compile time, modules whose result is decided by the output ranges of
+        /// their source modules (see Module::GetValueRange()) are replaced by the
+        /// deciding source module or by a constant (a Max or Min module with one
+        /// source module that always wins, a Select module whose control module or
+        /// constant control value always selects the same source module, a Clamp
+        /// module whose source module lies outside the clamping range), Invert
+        /// modules and Add or Multiply
+        /// modules with a Const source become scale/bias operations, and identity
+        /// transforms are removed. Collapsing chains of scale/bias operations and of
+        /// point transforms into one operation is optional because it rounds
+        /// differently (see EnableAffineCollapse()).
+        ///
+        /// Parameters of the flattened modules are copied into the program, so the
+        /// graph must be compiled again after any module in it is modified. The
+        /// modules must remain valid for the lifetime of this object because
+        /// generator and custom modules are still called directly.
+        ///
+        /// This noise module does not require any source modules.
+        class CompiledGraph : public Module {
+        public:
+            /// Constructor.
+            ///
+            /// The graph is empty until Compile() is called.
+            CompiledGraph() noexcept
+                : Module(GetSourceModuleCount()),
+                m_isAffineCollapseEnabled(false),
+                m_coordRegisterCount(0),
+                m_valueRegisterCount(0),
+                m_resultRegister(-1),
+                m_valueRange(ValueRange::Unbounded()) {
+            }
+
+            /// Constructor that compiles a noise-module graph.
+            ///
+            /// @param root The module whose output values this object generates.
+            ///
+            /// @throw noise::ExceptionNoModule If a module in the graph has a
+            /// required source module that is not set.
+            explicit CompiledGraph(const Module& root) : CompiledGraph() {
+                Compile(root);
+            }
+
+            /// Compiles a noise-module graph, replacing any previous program.
+            ///
+            /// @param root The module whose output values this object generates.
+            ///
+            /// @throw noise::ExceptionNoModule If a module in the graph has a
+            /// required source module that is not set.
+            /// @throw noise::ExceptionInvalidParam If the graph contains a cycle.
+            void Compile(const Module& root);
+
+            /// Enables or disables collapsing chains of affine operations.
+            ///
+            /// @param enable Specifies whether to collapse affine chains.
+            ///
+            /// If enabled, Compile() merges consecutive scale/bias operations (from
+            /// ScaleBias, Invert, and Add or Multiply modules with a Const source)
+            /// into one scale/bias operation, and consecutive ScalePoint,
+            /// TranslatePoint and RotatePoint modules into one 3x4 affine transform.
+            /// The merged coefficients are rounded once, so output values can differ
+            /// from the output values of the graph by a few units in the last place
+            /// (and generator modules evaluated at slightly different coordinates
+            /// can differ by more near a discontinuity). Takes effect at the next
+            /// call to Compile(); disabled by default.
+            inline void EnableAffineCollapse(bool enable = true) noexcept {
+                m_isAffineCollapseEnabled = enable;
+            }
+
+            /// Determines if chains of affine operations are collapsed.
+            ///
+            /// @returns True if affine collapsing is enabled, false otherwise.
+            [[nodiscard]] inline bool IsAffineCollapseEnabled() const noexcept {
+                return m_isAffineCollapseEnabled;
+            }
+
+            /// Returns the number of instructions in the compiled program.
+            ///
+            /// @returns The number of instructions, or 0 if no graph was compiled.
+            [[nodiscard]] inline int GetInstructionCount() const noexcept {
+                return static_cast<int>(m_program.size());
+            }
+
+            /// Returns a copy of this noise module with the same program.
+            ///
+            /// The copy calls the same generator and custom modules as this noise
+            /// module, as the program refers to them directly.
+            ///
+            /// @see Module::Clone()
+            [[nodiscard]] std::unique_ptr<Module> Clone() const override {
+                return CloneAs<CompiledGraph>();
+            }
+
+            /// Returns the number of source modules required by this noise module.
+            ///
+            /// @returns Always 0, as the compiled graph holds its own modules.
+            inline int GetSourceModuleCount() const noexcept override {
+                return 0;
+            }
+
+            /// Returns an interval that contains every output value of this noise module.
+            ///
+            /// @returns The output range of the compiled root module, as computed
+            /// by Compile(), or an unbounded interval if no graph was compiled.
+            ///
+            /// @see Module::GetValueRange()
+            [[nodiscard]] inline ValueRange GetValueRange() const override {
+                return m_valueRange;
+            }
+
+            /// Generates an output value given the coordinates of the specified input value.
+            ///
+            /// @pre A graph has been compiled via Compile().
+            ///
+            /// Evaluating one input value at a time runs every instruction once per
+            /// value; use GetValues() to evaluate many values.
+            double GetValue(double x, double y, double z) const noexcept override;
+
+            /// Generates an output value given the coordinates of the specified input
+            /// value, passing an evaluation context on to the modules that the
+            /// program calls.
+            ///
+            /// @pre A graph has been compiled via Compile().
+            ///
+            /// @see Module::GetValue(const EvalContext&, double, double, double)
+            double GetValue(const EvalContext& context, double x, double y, double z) const noexcept override;
+
+            /// Generates output values for a batch of input values.
+            ///
+            /// @pre A graph has been compiled via Compile().
+            ///
+            /// @see Module::GetValues()
+            void GetValues(const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override;
+
+            /// Generates output values for a batch of input values, passing an
+            /// evaluation context on to the modules that the program calls.
+            ///
+            /// @pre A graph has been compiled via Compile().
+            ///
+            /// The point-transforming instructions adjust the context as the
+            /// modules they were flattened from do.
+            ///
+            /// @see Module::GetValues()
+            void GetValues(const EvalContext& context, const double* x, const double* y,
+                const double* z, double* out, int count) const noexcept override;
+
+            /// @see Module::GetValues()
+            void GetValues(const EvalContext& context, const float* x, const float* y,
+                const float* z, float* out, int count) const noexcept override;
+
+            using Module::GetValues;
+
+        private:
+            /// Operations performed by the instructions of a compiled program.
+            enum class OpCode {
+                /// Calls the GetValues() method of a module at a coordinate register.
+                Evaluate,
+                /// Fills a value register with a constant (params[0]).
+                Const,
+                Abs,
+                /// Clamps to [params[0], params[1]].
+                Clamp,
+                /// Maps values onto the curve of a Curve module.
+                Curve,
+                /// Applies an exponent (params[0]) to normalized values, using the
+                /// fast power approximation if params[1] is nonzero.
+                Exponent,
+                Invert,
+                /// Multiplies by params[0] and adds params[1].
+                ScaleBias,
+                /// Maps values onto the terrace-forming curve of a Terrace module.
+                Terrace,
+                Add,
+                Max,
+                Min,
+                Multiply,
+                /// Raises source 1 to the power of source 0, using the fast power
+                /// approximation if params[0] is nonzero.
+                Power,
+                /// Blends sources 0 and 1 using the control values in source 2. A
+                /// source of -1 is computed by the matching sparse source, only at
+                /// the input values that give it a nonzero weight.
+                Blend,
+                /// Selects between the source modules of a Select module using the
+                /// control values in source 2; sources 0 and 1 hold the output values
+                /// of the flattened source modules, or -1 for a sparse source that is
+                /// evaluated only at the input values that need it. params hold the
+                /// lower bound, upper bound and edge falloff.
+                Select,
+                /// Writes a coordinate register scaled by params[0..2].
+                ScalePoint,
+                /// Writes a coordinate register translated by params[0..2].
+                TranslatePoint,
+                /// Writes a coordinate register rotated by the row-major matrix in params.
+                RotatePoint,
+                /// Writes a coordinate register transformed by the row-major 3x4 affine
+                /// matrix in params (each row holds three factors and a translation).
+                Affine,
+                /// Writes a coordinate register displaced by sources 0..2 times params[0].
+                Displace,
+                /// Writes a coordinate register displaced by the distortion modules
+                /// of a Turbulence module.
+                Turbulence
+            };
+
+            /// One instruction of a compiled program.
+            struct Instruction {
+                /// The operation to perform.
+                OpCode opCode;
+
+                /// The register that receives the result; a coordinate register for
+                /// the point-transforming operations, otherwise a value register.
+                int result;
+
+                /// The coordinate register that Evaluate and the point-transforming
+                /// operations read.
+                int coords;
+
+                /// The value registers that the operation reads.
+                std::array<int, 3> sources;
+
+                /// Operation parameters (see OpCode).
+                std::array<double, 12> params;
+
+                /// The module that Evaluate, Curve, Terrace and Select call.
+                const Module* module;
+
+                /// The sparse sources of a Select or Blend instruction: for a source
+                /// of -1, a sub-program compiled from the source module or the source
+                /// module itself; otherwise nullptr.
+                std::array<const Module*, 2> sparseSources;
+            };
+
+            struct CompileState;
+
+            /// Emits the instructions that compute a module's output values at a
+            /// coordinate register and returns the value register holding them.
+            int EmitValue(const Module& module, int coords, CompileState& state);
+
+            /// Emits a point-transforming instruction and returns its coordinate
+            /// register, or the register of an identical earlier instruction.
+            int EmitCoords(Instruction instruction, CompileState& state);
+
+            /// Sets source @a index of a Select or Blend instruction: the register of
+            /// a source module that other modules also use, or otherwise a sparse
+            /// source.
+            void EmitSource(const Module& source, int coords, Instruction& instruction,
+                int index, CompileState& state);
+
+            /// Emits an instruction that writes a value register and returns it, or
+            /// returns the register of an identical earlier instruction.
+            int EmitOp(Instruction instruction, CompileState& state);
+
+            /// Removes the instructions whose results are never read.
+            void RemoveDeadInstructions();
+
+            /// Assigns physical registers, reusing a register once its last reader has run.
+            void AllocateRegisters();
+
+            /// Runs an instruction that computes a value register from value registers
+            /// only (every operation except Evaluate, Select and the point-transforming
+            /// operations).
+            static void RunValueOp(const Instruction& instruction, const double* s0,
+                const double* s1, const double* s2, double* result, int count) noexcept;
+
+            /// Evaluates a sparse source at the input values of a block for which
+            /// @a isNeeded is true, and points @a source at the output values
+            /// (written to @a values). Does nothing if @a module is nullptr.
+            static void RunSparseSource(const Module* module, const bool* isNeeded,
+                const EvalContext& context, const double* x, const double* y, const double* z,
+                const double*& source, double* values, int count) noexcept;
+
+            /// Runs a Select instruction for one block, given the output values of
+            /// the control module. A selectable source whose output values are not
+            /// given (nullptr) is evaluated once, at only the input values that need
+            /// its output value.
+            static void RunSelect(const Instruction& instruction, const EvalContext& context,
+                const double* source0, const double* source1, const double* control,
+                const double* x, const double* y, const double* z, double* out, int count) noexcept;
+
+            /// Runs a Blend instruction for one block, given the output values of
+            /// the control module. A source whose output values are not given
+            /// (nullptr) is evaluated once, at only the input values that give it a
+            /// nonzero weight.
+            static void RunBlend(const Instruction& instruction, const EvalContext& context,
+                const double* source0, const double* source1, const double* control,
+                const double* x, const double* y, const double* z, double* out, int count) noexcept;
+
+            /// Runs the program for one block of at most BLOCK_SIZE input values.
+            /// coordContexts holds the evaluation context of each coordinate register.
+            void RunBlock(const double* x, const double* y, const double* z,
+                double* out, int count, double* registers, EvalContext* coordContexts) const noexcept;
+
+            /// Determines if chains of affine operations are collapsed.
+            bool m_isAffineCollapseEnabled;
+
+            /// The compiled program, in evaluation order.
+            std::vector<Instruction> m_program;
+
+            /// The sub-programs that the Select and Blend instructions run. They are
+            /// never modified after compiling, so copies of this object share them.
+            std::vector<std::shared_ptr<const CompiledGraph>> m_subgraphs;
+
+            /// Number of coordinate registers, including the input register 0.
+            int m_coordRegisterCount;
+
+            /// Number of value registers.
+            int m_valueRegisterCount;
+
+            /// Value register holding the output values of the root module.
+            int m_resultRegister;
+
+            /// Output range of the root module.
+            ValueRange m_valueRange;
+        };
+
+    } // namespace module
+
+} // namespace noise
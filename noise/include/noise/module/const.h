@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <algorithm> // For std::fill
 #include "modulebase.h"
 
 namespace noise {
@@ -63,6 +64,11 @@ namespace noise {
                 return m_constValue;
             }
 
+            /// @see Module::Clone()
+            [[nodiscard]] std::unique_ptr<Module> Clone() const override {
+                return CloneAs<Const>();
+            }
+
             /// Returns the number of source modules required by this noise module.
             ///
             /// @returns Always 0, as this module does not require any source modules.
@@ -70,6 +76,15 @@ namespace noise {
                 return 0;
             }
 
+            /// Returns an interval that contains every output value of this noise module.
+            ///
+            /// @returns The constant output value as both bounds.
+            ///
+            /// @see Module::GetValueRange()
+            [[nodiscard]] inline ValueRange GetValueRange() const override {
+                return { m_constValue, m_constValue };
+            }
+
             /// Returns the constant output value for the given input coordinates.
             ///
             /// @param x The x-coordinate of the input value (ignored).
@@ -81,14 +96,39 @@ namespace noise {
                 return m_constValue;
             }
 
+            /// Fills a batch of output values with the constant value.
+            ///
+            /// @see Module::GetValues()
+            inline void GetValues(const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(x, y, z, out, count);
+            }
+
+            using Module::GetValue;
+            using Module::GetValues;
+
             /// Sets the constant output value for this noise module.
             ///
             /// @param constValue The constant output value.
             inline void SetConstValue(double constValue) noexcept {
                 m_constValue = constValue;
+                InvalidateValueRanges();
             }
 
         protected:
+            /// Implements both overloads of GetValues(); Real is double or float.
+            template <typename Real>
+            void GetValuesImpl(const Real*, const Real*, const Real*,
+                Real* out, int count) const noexcept {
+                std::fill(out, out + count, static_cast<Real>(m_constValue));
+            }
+
             /// The constant value to output.
             double m_constValue;
         };
@@ -73,7 +73,7 @@ namespace noise {
         class Curve : public Module {
         public:
             /// Constructor.
-            Curve() noexcept : Module(GetSourceModuleCount()), m_controlPoints() {}
+            Curve() noexcept : Module(GetSourceModuleCount()), m_controlPoints(), m_segments() {}
 
             /// Adds a control point to the cubic spline.
             ///
@@ -89,6 +89,8 @@ namespace noise {
             /// Removes all control points from the cubic spline.
             inline void ClearAllControlPoints() noexcept {
                 m_controlPoints.clear();
+                m_segments.clear();
+                InvalidateValueRanges();
             }
 
             /// Returns a pointer to the array of control points on the curve.
@@ -109,6 +111,11 @@ namespace noise {
                 return static_cast<int>(m_controlPoints.size());
             }
 
+            /// @see Module::Clone()
+            [[nodiscard]] std::unique_ptr<Module> Clone() const override {
+                return CloneAs<Curve>();
+            }
+
             /// Returns the number of source modules required by this noise module.
             ///
             /// @returns Always 1, as this module requires exactly one source module.
@@ -116,6 +123,13 @@ namespace noise {
                 return 1;
             }
 
+            /// Returns an interval that contains every output value of this noise module.
+            ///
+            /// @returns The range of the curve over the output range of the source module.
+            ///
+            /// @see Module::GetValueRange()
+            [[nodiscard]] ValueRange GetValueRange() const override;
+
             /// Maps the source module's output value onto the cubic spline.
             ///
             /// @param x The x-coordinate of the input value.
@@ -127,7 +141,41 @@ namespace noise {
             /// @pre At least four control points have been added.
             double GetValue(double x, double y, double z) const noexcept override;
 
+            /// @see Module::GetValue(const EvalContext&, double, double, double)
+            double GetValue(const EvalContext& context, double x, double y, double z) const noexcept override;
+
+            /// Maps the source module's output values onto the cubic spline for a batch
+            /// of input values.
+            ///
+            /// @pre The source module (index 0) has been set.
+            /// @pre At least four control points have been added.
+            ///
+            /// @see Module::GetValues()
+            void GetValues(const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override;
+
+            /// @see Module::GetValues()
+            void GetValues(const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override;
+
+            /// @see Module::GetValues()
+            void GetValues(const EvalContext& context, const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override;
+
+            /// @see Module::GetValues()
+            void GetValues(const EvalContext& context, const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override;
+
         protected:
+            /// CompiledGraph reads the internal state of this module when it
+            /// flattens a graph that contains it.
+            friend class CompiledGraph;
+
+            /// Implements the overloads of GetValues(); Real is double or float.
+            template <typename Real>
+            void GetValuesImpl(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+                Real* out, int count) const noexcept;
+
             /// Finds the position to insert a new control point while maintaining sorted order.
             ///
             /// @param inputValue The input value of the control point to insert.
@@ -136,6 +184,13 @@ namespace noise {
             /// @throw noise::ExceptionInvalidParam If the input value already exists.
             int FindInsertionPos(double inputValue) const;
 
+            /// Maps an output value from the source module onto the cubic spline.
+            ///
+            /// @param sourceValue The output value from the source module.
+            ///
+            /// @returns The mapped output value.
+            double MapSourceValue(double sourceValue) const noexcept;
+
             /// Inserts a control point at the specified position in the control point vector.
             ///
             /// @param insertionPos The position to insert the control point.
@@ -143,8 +198,30 @@ namespace noise {
             /// @param outputValue The output value of the control point.
             void InsertAtPos(int insertionPos, double inputValue, double outputValue);
 
+            /// Recomputes the coefficients of every segment of the curve.
+            void CalcSegments();
+
+            /// The cubic polynomial between two adjacent control points.
+            ///
+            /// The coefficients are the ones that CubicInterp() computes from the
+            /// output values of the four control points around the segment.
+            struct Segment {
+                /// The input value of the control point at the start of the segment.
+                double inputValue;
+
+                /// The input value of the next control point minus inputValue.
+                double inputWidth;
+
+                /// The coefficients of a^3, a^2, a and 1.
+                double p, q, r, s;
+            };
+
             /// Vector storing the control points, sorted by input value.
             std::vector<ControlPoint> m_controlPoints;
+
+            /// The segments between adjacent control points, computed by
+            /// CalcSegments() whenever a control point is added.
+            std::vector<Segment> m_segments;
         };
 
     } // namespace module
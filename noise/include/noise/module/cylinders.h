@@ -81,6 +81,11 @@ namespace noise {
                 return m_frequency;
             }
 
+            /// @see Module::Clone()
+            [[nodiscard]] std::unique_ptr<Module> Clone() const override {
+                return CloneAs<Cylinders>();
+            }
+
             /// Returns the number of source modules required by this noise module.
             ///
             /// @returns Always 0, as this module does not require any source modules.
@@ -88,6 +93,15 @@ namespace noise {
                 return 0;
             }
 
+            /// Returns an interval that contains every output value of this noise module.
+            ///
+            /// @returns Always -1.0 to +1.0.
+            ///
+            /// @see Module::GetValueRange()
+            [[nodiscard]] inline ValueRange GetValueRange() const override {
+                return { -1.0, 1.0 };
+            }
+
             /// Generates the output value based on the distance to the nearest cylinder surface.
             ///
             /// @param x The x-coordinate of the input value.
@@ -113,6 +127,23 @@ namespace noise {
                 return 1.0 - (nearestDist * 4.0); // Maps to [-1.0, 1.0] range.
             }
 
+            /// Generates the concentric-cylinder values for a batch of input values.
+            ///
+            /// @see Module::GetValues()
+            inline void GetValues(const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(x, y, z, out, count);
+            }
+
+            using Module::GetValue;
+            using Module::GetValues;
+
             /// Sets the frequency of the concentric cylinders.
             ///
             /// @param frequency The frequency of the concentric cylinders.
@@ -123,6 +154,15 @@ namespace noise {
             }
 
         protected:
+            /// Implements both overloads of GetValues(); Real is double or float.
+            template <typename Real>
+            void GetValuesImpl(const Real* x, const Real* y, const Real* z,
+                Real* out, int count) const noexcept {
+                for (int i = 0; i < count; ++i) {
+                    out[i] = static_cast<Real>(Cylinders::GetValue(x[i], y[i], z[i]));
+                }
+            }
+
             /// Frequency of the concentric cylinders.
             double m_frequency;
         };
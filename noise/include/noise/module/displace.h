@@ -30,6 +30,7 @@
 #pragma once
 
 #include <cassert>  // For assert
+#include <vector>   // For std::vector
 #include "modulebase.h"
 
 namespace noise {
@@ -54,6 +55,11 @@ namespace noise {
             /// Constructor.
             Displace() noexcept : Module(GetSourceModuleCount()) {}
 
+            /// @see Module::Clone()
+            [[nodiscard]] std::unique_ptr<Module> Clone() const override {
+                return CloneAs<Displace>();
+            }
+
             /// Returns the number of source modules required by this noise module.
             ///
             /// @returns Always 4, as this module requires four source modules.
@@ -61,6 +67,15 @@ namespace noise {
                 return 4;
             }
 
+            /// Returns an interval that contains every output value of this noise module.
+            ///
+            /// @returns The output range of the source module (index 0).
+            ///
+            /// @see Module::GetValueRange()
+            [[nodiscard]] inline ValueRange GetValueRange() const override {
+                return GetSourceModule(0).GetValueRange();
+            }
+
             /// Returns the displaced output value from the source module.
             ///
             /// @param x The x-coordinate of the input value.
@@ -70,15 +85,47 @@ namespace noise {
             /// @returns The displaced output value.
             /// @pre All source modules (indices 0, 1, 2, and 3) have been set.
             inline double GetValue(double x, double y, double z) const noexcept override {
+                return GetValue(EvalContext(), x, y, z);
+            }
+
+            /// @see Module::GetValue(const EvalContext&, double, double, double)
+            inline double GetValue(const EvalContext& context, double x, double y, double z) const noexcept override {
                 assert(m_sourceModules[0] != nullptr && "Source module 0 must be set before calling GetValue");
                 assert(m_sourceModules[1] != nullptr && "X displace module (source module 1) must be set before calling GetValue");
                 assert(m_sourceModules[2] != nullptr && "Y displace module (source module 2) must be set before calling GetValue");
                 assert(m_sourceModules[3] != nullptr && "Z displace module (source module 3) must be set before calling GetValue");
 
-                const double xDisplace = m_sourceModules[1]->GetValue(x, y, z);
-                const double yDisplace = m_sourceModules[2]->GetValue(x, y, z);
-                const double zDisplace = m_sourceModules[3]->GetValue(x, y, z);
-                return m_sourceModules[0]->GetValue(x + xDisplace, y + yDisplace, z + zDisplace);
+                const double xDisplace = m_sourceModules[1]->GetValue(context, x, y, z);
+                const double yDisplace = m_sourceModules[2]->GetValue(context, x, y, z);
+                const double zDisplace = m_sourceModules[3]->GetValue(context, x, y, z);
+                return m_sourceModules[0]->GetValue(context, x + xDisplace, y + yDisplace, z + zDisplace);
+            }
+
+            /// Returns the displaced output values from the source module for a batch
+            /// of input values.
+            ///
+            /// @see Module::GetValues()
+            inline void GetValues(const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(EvalContext(), x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(EvalContext(), x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const EvalContext& context, const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(context, x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const EvalContext& context, const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(context, x, y, z, out, count);
             }
 
             /// Sets the x displacement module.
@@ -89,6 +136,7 @@ namespace noise {
             inline void SetXDisplaceModule(const Module& xDisplaceModule) noexcept {
                 assert(m_sourceModules.size() >= 4);
                 m_sourceModules[1] = &xDisplaceModule;
+                InvalidateValueRanges();
             }
 
             /// Sets the y displacement module.
@@ -99,6 +147,7 @@ namespace noise {
             inline void SetYDisplaceModule(const Module& yDisplaceModule) noexcept {
                 assert(m_sourceModules.size() >= 4);
                 m_sourceModules[2] = &yDisplaceModule;
+                InvalidateValueRanges();
             }
 
             /// Sets the z displacement module.
@@ -109,6 +158,7 @@ namespace noise {
             inline void SetZDisplaceModule(const Module& zDisplaceModule) noexcept {
                 assert(m_sourceModules.size() >= 4);
                 m_sourceModules[3] = &zDisplaceModule;
+                InvalidateValueRanges();
             }
 
             /// Sets all displacement modules.
@@ -125,6 +175,31 @@ namespace noise {
                 m_sourceModules[1] = &xDisplaceModule;
                 m_sourceModules[2] = &yDisplaceModule;
                 m_sourceModules[3] = &zDisplaceModule;
+                InvalidateValueRanges();
+            }
+
+        private:
+            /// Implements the overloads of GetValues(); Real is double or float.
+            template <typename Real>
+            void GetValuesImpl(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+                Real* out, int count) const noexcept {
+                assert(m_sourceModules[0] != nullptr && "Source module 0 must be set before calling GetValues");
+                assert(m_sourceModules[1] != nullptr && "X displace module (source module 1) must be set before calling GetValues");
+                assert(m_sourceModules[2] != nullptr && "Y displace module (source module 2) must be set before calling GetValues");
+                assert(m_sourceModules[3] != nullptr && "Z displace module (source module 3) must be set before calling GetValues");
+
+                std::vector<Real> nx(static_cast<size_t>(count));
+                std::vector<Real> ny(static_cast<size_t>(count));
+                std::vector<Real> nz(static_cast<size_t>(count));
+                m_sourceModules[1]->GetValues(context, x, y, z, nx.data(), count);
+                m_sourceModules[2]->GetValues(context, x, y, z, ny.data(), count);
+                m_sourceModules[3]->GetValues(context, x, y, z, nz.data(), count);
+                for (int i = 0; i < count; ++i) {
+                    nx[i] = x[i] + nx[i];
+                    ny[i] = y[i] + ny[i];
+                    nz[i] = z[i] + nz[i];
+                }
+                m_sourceModules[0]->GetValues(context, nx.data(), ny.data(), nz.data(), out, count);
             }
         };
 
@@ -30,8 +30,10 @@
 
 #pragma once
 
-#include <cassert> // For assert
-#include <cmath>   // For std::pow, std::fabs
+#include <algorithm> // For std::min, std::max
+#include <cassert>   // For assert
+#include <cmath>     // For std::pow, std::fabs
+#include "../fastpow.h"
 #include "modulebase.h"
 
 namespace noise {
@@ -54,13 +56,37 @@ namespace noise {
         /// - Apply exponent: \( \text{exponentiated} = \text{normalized}^{\text{exponent}} \)
         /// - Rescale: \( \text{output} = \text{exponentiated} \cdot 2 - 1 \)
         ///
+        /// The exponential curve is evaluated by std::pow() unless the fast power
+        /// approximation is enabled (see EnableFastPow()).
+        ///
         /// This noise module requires one source module.
         class Exponent : public Module {
         public:
             /// Constructor.
             ///
             /// The default exponent is set to DEFAULT_EXPONENT.
-            Exponent() noexcept : Module(GetSourceModuleCount()), m_exponent(DEFAULT_EXPONENT) {}
+            Exponent() noexcept
+                : Module(GetSourceModuleCount()),
+                m_exponent(DEFAULT_EXPONENT),
+                m_isFastPowEnabled(false),
+                m_fastPower(DEFAULT_EXPONENT) {
+            }
+
+            /// Enables or disables the fast power approximation.
+            ///
+            /// @param enable Specifies whether to use the fast power approximation.
+            ///
+            /// If enabled, the exponential curve is evaluated by a noise::FastPower
+            /// instead of std::pow(). An exponent that is a multiple of 1/8 (such as
+            /// 1.25 or 1.375) is evaluated by multiplications and square roots, and
+            /// any other exponent by polynomial approximations of log2 and exp2 that
+            /// are evaluated four values at a time by GetValues() on processors that
+            /// support AVX2. The result differs from the std::pow() result by a
+            /// relative error of less than FAST_POW_MAX_RELATIVE_ERROR. Disabled by
+            /// default.
+            inline void EnableFastPow(bool enable = true) noexcept {
+                m_isFastPowEnabled = enable;
+            }
 
             /// Returns the exponent value used for the exponential curve.
             ///
@@ -69,6 +95,18 @@ namespace noise {
                 return m_exponent;
             }
 
+            /// Determines if the fast power approximation is enabled.
+            ///
+            /// @returns True if the fast power approximation is enabled, false otherwise.
+            [[nodiscard]] inline bool IsFastPowEnabled() const noexcept {
+                return m_isFastPowEnabled;
+            }
+
+            /// @see Module::Clone()
+            [[nodiscard]] std::unique_ptr<Module> Clone() const override {
+                return CloneAs<Exponent>();
+            }
+
             /// Returns the number of source modules required by this noise module.
             ///
             /// @returns Always 1, as this module requires exactly one source module.
@@ -76,6 +114,36 @@ namespace noise {
                 return 1;
             }
 
+            /// Returns an interval that contains every output value of this noise module.
+            ///
+            /// @returns The output range of the source module mapped through the
+            /// exponential curve.
+            ///
+            /// @see Module::GetValueRange()
+            [[nodiscard]] inline ValueRange GetValueRange() const override {
+                const ValueRange source = GetSourceModule(0).GetValueRange();
+                const double lower = (source.lowerBound + 1.0) / 2.0;
+                const double upper = (source.upperBound + 1.0) / 2.0;
+                // The curve depends on the magnitude of the normalized value only.
+                double minMagnitude = 0.0;
+                if (lower > 0.0) {
+                    minMagnitude = lower;
+                } else if (upper < 0.0) {
+                    minMagnitude = -upper;
+                }
+                const double maxMagnitude = std::max(std::fabs(lower), std::fabs(upper));
+                const double value0 = std::pow(minMagnitude, m_exponent) * 2.0 - 1.0;
+                const double value1 = std::pow(maxMagnitude, m_exponent) * 2.0 - 1.0;
+                const ValueRange range = { std::min(value0, value1), std::max(value0, value1) };
+                if (!m_isFastPowEnabled) {
+                    return range;
+                }
+                // Widen the bounds to cover the error of the approximation and
+                // rounding in the rescaling.
+                return { range.lowerBound - 2.0 * FAST_POW_MAX_RELATIVE_ERROR * (std::fabs(range.lowerBound) + 1.0),
+                    range.upperBound + 2.0 * FAST_POW_MAX_RELATIVE_ERROR * (std::fabs(range.upperBound) + 1.0) };
+            }
+
             /// Maps the source module's output value onto an exponential curve.
             ///
             /// @param x The x-coordinate of the input value.
@@ -85,24 +153,111 @@ namespace noise {
             /// @returns The mapped output value in the range [-1.0, 1.0].
             /// @pre The source module (index 0) has been set.
             inline double GetValue(double x, double y, double z) const noexcept override {
+                return GetValue(EvalContext(), x, y, z);
+            }
+
+            /// @see Module::GetValue(const EvalContext&, double, double, double)
+            inline double GetValue(const EvalContext& context, double x, double y, double z) const noexcept override {
                 assert(m_sourceModules[0] != nullptr && "Source module must be set before calling GetValue");
 
-                const double value = m_sourceModules[0]->GetValue(x, y, z);
+                const double value = m_sourceModules[0]->GetValue(context, x, y, z);
                 const double normalized = (value + 1.0) / 2.0;
-                const double exponentiated = std::pow(std::fabs(normalized), m_exponent);
+                const double exponentiated = m_isFastPowEnabled
+                    ? m_fastPower(std::fabs(normalized)) : std::pow(std::fabs(normalized), m_exponent);
                 return exponentiated * 2.0 - 1.0;
             }
 
+            /// Maps the source module's output values onto the exponential curve for a
+            /// batch of input values.
+            ///
+            /// @see Module::GetValues()
+            inline void GetValues(const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(EvalContext(), x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(EvalContext(), x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const EvalContext& context, const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(context, x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const EvalContext& context, const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(context, x, y, z, out, count);
+            }
+
             /// Sets the exponent value for the exponential curve.
             ///
             /// @param exponent The exponent value to set.
             inline void SetExponent(double exponent) noexcept {
                 m_exponent = exponent;
+                m_fastPower = FastPower(exponent);
+                InvalidateValueRanges();
             }
 
         protected:
+            /// Implements the overloads of GetValues(); Real is double or float.
+            template <typename Real>
+            void GetValuesImpl(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+                Real* out, int count) const noexcept {
+                assert(m_sourceModules[0] != nullptr && "Source module must be set before calling GetValues");
+                const Real exponent = static_cast<Real>(m_exponent);
+                m_sourceModules[0]->GetValues(context, x, y, z, out, count);
+                if (m_isFastPowEnabled) {
+                    ApplyFastPower(out, count);
+                    return;
+                }
+                for (int i = 0; i < count; ++i) {
+                    const Real normalized = (out[i] + Real(1.0)) / Real(2.0);
+                    out[i] = std::pow(std::fabs(normalized), exponent) * Real(2.0) - Real(1.0);
+                }
+            }
+
+            /// Maps a batch of source values onto the exponential curve using the
+            /// fast power approximation.
+            inline void ApplyFastPower(double* values, int count) const noexcept {
+                for (int i = 0; i < count; ++i) {
+                    values[i] = std::fabs((values[i] + 1.0) / 2.0);
+                }
+                m_fastPower(values, values, count);
+                for (int i = 0; i < count; ++i) {
+                    values[i] = values[i] * 2.0 - 1.0;
+                }
+            }
+
+            /// Single-precision counterpart of ApplyFastPower(); the curve is
+            /// evaluated in double precision.
+            inline void ApplyFastPower(float* values, int count) const noexcept {
+                constexpr int BLOCK_SIZE = 256;
+                double block[BLOCK_SIZE];
+                for (int start = 0; start < count; start += BLOCK_SIZE) {
+                    const int blockCount = std::min(BLOCK_SIZE, count - start);
+                    for (int i = 0; i < blockCount; ++i) {
+                        block[i] = values[start + i];
+                    }
+                    ApplyFastPower(block, blockCount);
+                    for (int i = 0; i < blockCount; ++i) {
+                        values[start + i] = static_cast<float>(block[i]);
+                    }
+                }
+            }
+
             /// Exponent to apply to the normalized output value from the source module.
             double m_exponent;
+
+            /// Determines if the fast power approximation is enabled.
+            bool m_isFastPowEnabled;
+
+            /// The exponent prepared for the fast power approximation.
+            FastPower m_fastPower;
         };
 
     } // namespace module
@@ -0,0 +1,125 @@
+// graphreplica.h
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+
+#pragma once
+
+#include <map>      // For std::map
+#include <memory>   // For std::unique_ptr
+#include <set>      // For std::set
+#include <vector>   // For std::vector
+#include "modulebase.h"
+
+namespace noise {
+
+    namespace module {
+
+        /// A copy of a noise-module graph.
+        ///
+        /// Replicate() walks the graph of source modules below a root module once,
+        /// copies each noise module with Module::Clone(), and connects each copy to
+        /// the copies of its source modules. A module that is shared by several
+        /// other modules in the graph is copied once, and the copies share it in
+        /// the same way. The copies are owned by this object.
+        ///
+        /// A replica generates the same output values as the original graph but
+        /// shares no noise module with it, so each thread can evaluate its own
+        /// replica without any synchronization, even if the graph contains modules
+        /// that keep mutable state. A custom module that does not override Clone()
+        /// is the exception: the replica refers to the original module (and its
+        /// source modules) instead of a copy.
+        ///
+        /// Changing a noise module of the original graph does not change the
+        /// replica; use GetCopy() to change the copy, or call Replicate() again.
+        class GraphReplica {
+        public:
+            /// Constructor.
+            ///
+            /// The replica is empty until Replicate() is called.
+            GraphReplica() noexcept : m_root(nullptr) {
+            }
+
+            /// Constructor that copies a noise-module graph.
+            ///
+            /// @param root The root module of the graph to copy.
+            ///
+            /// @throw noise::ExceptionNoModule If a module in the graph has a
+            /// required source module that is not set.
+            /// @throw noise::ExceptionInvalidParam If the graph contains a cycle.
+            explicit GraphReplica(const Module& root) : GraphReplica() {
+                Replicate(root);
+            }
+
+            /// Copies a noise-module graph, replacing any previous copy.
+            ///
+            /// @param root The root module of the graph to copy.
+            ///
+            /// @throw noise::ExceptionNoModule If a module in the graph has a
+            /// required source module that is not set.
+            /// @throw noise::ExceptionInvalidParam If the graph contains a cycle.
+            ///
+            /// The modules of the original graph must remain valid while this
+            /// object refers to any of them (see GraphReplica).
+            void Replicate(const Module& root);
+
+            /// Returns the copy of the root module.
+            ///
+            /// @returns The copy of the root module that was passed to Replicate().
+            ///
+            /// @throw noise::ExceptionNoModule If no graph was copied.
+            [[nodiscard]] const Module& GetRoot() const {
+                if (m_root == nullptr) {
+                    throw noise::ExceptionNoModule();
+                }
+                return *m_root;
+            }
+
+            /// Returns the copy of a noise module of the original graph.
+            ///
+            /// @param original A noise module of the graph that was copied.
+            ///
+            /// @returns The copy of @a original.
+            ///
+            /// @throw noise::ExceptionInvalidParam If @a original is not a module of
+            /// the copied graph, or could not be copied (see Module::Clone()).
+            ///
+            /// The copy may be modified (e.g., to give each thread its own seed)
+            /// while no thread evaluates the replica.
+            [[nodiscard]] Module& GetCopy(const Module& original);
+
+            /// Returns the number of noise modules that were copied.
+            ///
+            /// @returns The number of copies owned by this object, or 0 if no graph
+            /// was copied.
+            [[nodiscard]] inline int GetCopyCount() const noexcept {
+                return static_cast<int>(m_copies.size());
+            }
+
+        private:
+            /// Returns the copy of a noise module, copying it and its source modules
+            /// if it has not been copied yet. inProgress holds the modules whose
+            /// source modules are being copied.
+            const Module& CopyModule(const Module& module, std::set<const Module*>& inProgress);
+
+            /// The copies, in the order in which they were made.
+            std::vector<std::unique_ptr<Module>> m_copies;
+
+            /// The copy of each noise module of the original graph, or nullptr for
+            /// a module that could not be copied and is shared with the original.
+            std::map<const Module*, Module*> m_copyOf;
+
+            /// The copy of the root module.
+            const Module* m_root;
+        };
+
+    } // namespace module
+
+} // namespace noise
@@ -48,6 +48,11 @@ namespace noise {
             /// Constructor.
             Invert() noexcept : Module(GetSourceModuleCount()) {}
 
+            /// @see Module::Clone()
+            [[nodiscard]] std::unique_ptr<Module> Clone() const override {
+                return CloneAs<Invert>();
+            }
+
             /// Returns the number of source modules required by this noise module.
             ///
             /// @returns Always 1, as this module requires exactly one source module.
@@ -55,6 +60,16 @@ namespace noise {
                 return 1;
             }
 
+            /// Returns an interval that contains every output value of this noise module.
+            ///
+            /// @returns The output range of the source module, negated.
+            ///
+            /// @see Module::GetValueRange()
+            [[nodiscard]] inline ValueRange GetValueRange() const override {
+                const ValueRange source = GetSourceModule(0).GetValueRange();
+                return { -source.upperBound, -source.lowerBound };
+            }
+
             /// Returns the negated output value from the source module.
             ///
             /// @param x The x-coordinate of the input value.
@@ -64,8 +79,52 @@ namespace noise {
             /// @returns The negated output value.
             /// @pre The source module (index 0) has been set.
             inline double GetValue(double x, double y, double z) const noexcept override {
+                return GetValue(EvalContext(), x, y, z);
+            }
+
+            /// @see Module::GetValue(const EvalContext&, double, double, double)
+            inline double GetValue(const EvalContext& context, double x, double y, double z) const noexcept override {
                 assert(m_sourceModules[0] != nullptr && "Source module must be set before calling GetValue");
-                return -(m_sourceModules[0]->GetValue(x, y, z));
+                return -(m_sourceModules[0]->GetValue(context, x, y, z));
+            }
+
+            /// Generates the negated output values from the source module for a batch
+            /// of input values.
+            ///
+            /// @see Module::GetValues()
+            inline void GetValues(const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(EvalContext(), x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(EvalContext(), x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const EvalContext& context, const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(context, x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const EvalContext& context, const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(context, x, y, z, out, count);
+            }
+
+        private:
+            /// Implements the overloads of GetValues(); Real is double or float.
+            template <typename Real>
+            void GetValuesImpl(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+                Real* out, int count) const noexcept {
+                assert(m_sourceModules[0] != nullptr && "Source module must be set before calling GetValues");
+                m_sourceModules[0]->GetValues(context, x, y, z, out, count);
+                for (int i = 0; i < count; ++i) {
+                    out[i] = -out[i];
+                }
             }
         };
 
@@ -30,6 +30,7 @@
 
 #include <algorithm> // For std::min
 #include <cassert>   // For assert
+#include <vector>    // For std::vector
 #include "modulebase.h"
 
 namespace noise {
@@ -41,11 +42,22 @@ namespace noise {
         /// @image html modulemin.png
         ///
         /// This noise module requires two source modules.
+        ///
+        /// If the output ranges of the source modules (see GetValueRange()) show
+        /// that one source module always outputs the smaller value, GetValues()
+        /// evaluates only that source module. The ranges are checked on the first
+        /// batch and again only after a change to a noise module (see
+        /// Module::InvalidateValueRanges()).
         class Min : public Module {
         public:
             /// Constructor.
             Min() noexcept : Module(GetSourceModuleCount()) {}
 
+            /// @see Module::Clone()
+            [[nodiscard]] std::unique_ptr<Module> Clone() const override {
+                return CloneAs<Min>();
+            }
+
             /// Returns the number of source modules required by this noise module.
             ///
             /// @returns Always 2, as this module requires exactly two source modules.
@@ -53,6 +65,18 @@ namespace noise {
                 return 2;
             }
 
+            /// Returns an interval that contains every output value of this noise module.
+            ///
+            /// @returns The range of the smaller of two values from the output ranges
+            /// of the source modules.
+            ///
+            /// @see Module::GetValueRange()
+            [[nodiscard]] inline ValueRange GetValueRange() const override {
+                const ValueRange source0 = GetSourceModule(0).GetValueRange();
+                const ValueRange source1 = GetSourceModule(1).GetValueRange();
+                return { std::min(source0.lowerBound, source1.lowerBound), std::min(source0.upperBound, source1.upperBound) };
+            }
+
             /// Returns the smaller of the output values from the two source modules.
             ///
             /// @param x The x-coordinate of the input value.
@@ -62,16 +86,98 @@ namespace noise {
             /// @returns The smaller of the two output values.
             /// @pre Both source modules (indices 0 and 1) have been set.
             inline double GetValue(double x, double y, double z) const noexcept override {
+                return GetValue(EvalContext(), x, y, z);
+            }
+
+            /// @see Module::GetValue(const EvalContext&, double, double, double)
+            inline double GetValue(const EvalContext& context, double x, double y, double z) const noexcept override {
                 assert(m_sourceModules[0] != nullptr && "Source module 0 must be set before calling GetValue");
                 assert(m_sourceModules[1] != nullptr && "Source module 1 must be set before calling GetValue");
 
-                const double v0 = m_sourceModules[0]->GetValue(x, y, z);
-                const double v1 = m_sourceModules[1]->GetValue(x, y, z);
+                const double v0 = m_sourceModules[0]->GetValue(context, x, y, z);
+                const double v1 = m_sourceModules[1]->GetValue(context, x, y, z);
 #ifdef min
 #undef min
 #endif
                 return std::min(v0, v1);
             }
+
+            /// Generates the smaller of the source modules' output values for a batch
+            /// of input values.
+            ///
+            /// @see Module::GetValues()
+            inline void GetValues(const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(EvalContext(), x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(EvalContext(), x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const EvalContext& context, const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(context, x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const EvalContext& context, const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(context, x, y, z, out, count);
+            }
+
+        private:
+            /// CompiledGraph reads the internal state of this module when it
+            /// flattens a graph that contains it.
+            friend class CompiledGraph;
+
+            /// Implements the overloads of GetValues(); Real is double or float.
+            template <typename Real>
+            void GetValuesImpl(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+                Real* out, int count) const noexcept {
+                assert(m_sourceModules[0] != nullptr && "Source module 0 must be set before calling GetValues");
+                assert(m_sourceModules[1] != nullptr && "Source module 1 must be set before calling GetValues");
+
+                const int dominantSource = m_dominantSource.Get([this] {
+                    return GetDominantSource();
+                });
+                if (dominantSource >= 0) {
+                    m_sourceModules[dominantSource]->GetValues(context, x, y, z, out, count);
+                    return;
+                }
+
+                std::vector<Real> values1(static_cast<size_t>(count));
+                m_sourceModules[0]->GetValues(context, x, y, z, out, count);
+                m_sourceModules[1]->GetValues(context, x, y, z, values1.data(), count);
+                for (int i = 0; i < count; ++i) {
+                    out[i] = std::min(out[i], values1[i]);
+                }
+            }
+
+            /// Returns the index of the source module whose output value GetValue()
+            /// returns at every input value, according to the output ranges of the
+            /// source modules, or -1 if it depends on the input value.
+            ///
+            /// std::min() returns its first argument if both values are equal, so
+            /// source module 0 wins a tie.
+            [[nodiscard]] int GetDominantSource() const {
+                const ValueRange range0 = m_sourceModules[0]->GetValueRange();
+                const ValueRange range1 = m_sourceModules[1]->GetValueRange();
+                if (range0.upperBound <= range1.lowerBound) {
+                    return 0;
+                }
+                if (range1.upperBound < range0.lowerBound) {
+                    return 1;
+                }
+                return -1;
+            }
+
+            /// The source module that the output ranges of the source modules
+            /// select (see GetDominantSource()).
+            RangeDecision m_dominantSource;
         };
 
     } // namespace module
@@ -31,11 +31,13 @@
 #include "cache.h"
 #include "checkerboard.h"
 #include "clamp.h"
+#include "compiledgraph.h"
 #include "const.h"
 #include "curve.h"
 #include "cylinders.h"
 #include "displace.h"
 #include "exponent.h"
+#include "graphreplica.h"
 #include "invert.h"
 #include "max.h"
 #include "min.h"
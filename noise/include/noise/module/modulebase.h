@@ -31,7 +31,14 @@
 
 #pragma once
 
+#include <algorithm> // For std::min, std::max
+#include <atomic>    // For std::atomic
 #include <cassert>  // For assert
+#include <cmath>    // For std::fabs, std::isnan
+#include <cstdint>  // For std::uint64_t
+#include <limits>   // For std::numeric_limits
+#include <memory>   // For std::unique_ptr, std::make_unique
+#include <typeinfo> // For typeid
 #include <vector>   // For std::vector
 #include "../exception.h"
 
@@ -39,6 +46,168 @@ namespace noise {
 
     namespace module {
 
+        /// A closed interval that contains the output values of a noise module.
+        ///
+        /// @see Module::GetValueRange()
+        struct ValueRange {
+            /// Lower bound of the interval.
+            double lowerBound;
+
+            /// Upper bound of the interval.
+            double upperBound;
+
+            /// Returns the interval that contains all values.
+            [[nodiscard]] static ValueRange Unbounded() noexcept {
+                return { -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity() };
+            }
+
+            /// Returns the smallest interval that contains this interval and another.
+            [[nodiscard]] ValueRange Union(const ValueRange& other) const noexcept {
+                return { std::min(lowerBound, other.lowerBound), std::max(upperBound, other.upperBound) };
+            }
+
+            /// Returns the interval that contains the products of a value in this
+            /// interval and a value in another.
+            [[nodiscard]] ValueRange Product(const ValueRange& other) const noexcept {
+                const double products[4] = {
+                    lowerBound * other.lowerBound, lowerBound * other.upperBound,
+                    upperBound * other.lowerBound, upperBound * other.upperBound
+                };
+                ValueRange range = { products[0], products[0] };
+                for (double product : products) {
+                    if (std::isnan(product)) {
+                        // An infinite bound times zero.
+                        return Unbounded();
+                    }
+                    range.lowerBound = std::min(range.lowerBound, product);
+                    range.upperBound = std::max(range.upperBound, product);
+                }
+                return range;
+            }
+        };
+
+        /// Sample spacing, in lattice cells of a noise octave, at which
+        /// EvalContext::GetOctaveWeight() starts to fade the octave out.
+        inline constexpr double LOD_FADE_START = 0.25;
+
+        /// Sample spacing, in lattice cells of a noise octave, at which
+        /// EvalContext::GetOctaveWeight() drops the octave.
+        inline constexpr double LOD_FADE_END = 0.5;
+
+        /// Counters that noise modules increment while they generate output values
+        /// (see EvalContext::stats).
+        ///
+        /// The counters are not synchronized, so each thread that evaluates a
+        /// noise-module graph should use its own EvalStats object and add the
+        /// counts together afterwards.
+        struct EvalStats {
+            /// Number of output values that Cache modules returned from a cache.
+            std::uint64_t cacheHits = 0;
+
+            /// Number of output values that Cache modules requested from their
+            /// source modules.
+            std::uint64_t cacheMisses = 0;
+
+            /// Number of octaves of coherent noise that the Perlin, Billow,
+            /// RidgedMulti and Turbulence modules evaluated, summed over the input
+            /// values.
+            std::uint64_t octaveCount = 0;
+
+            /// Adds the counts of another EvalStats object to these counts.
+            EvalStats& operator+=(const EvalStats& other) noexcept {
+                cacheHits += other.cacheHits;
+                cacheMisses += other.cacheMisses;
+                octaveCount += other.octaveCount;
+                return *this;
+            }
+        };
+
+        /// Describes how input values are evaluated: how they are sampled, so that
+        /// noise modules can skip detail that the samples cannot resolve, and where
+        /// noise modules record statistics.
+        ///
+        /// A noise module passes the context on to its source modules, adjusted to
+        /// their input values (e.g., ScalePoint scales the sample spacing). With the
+        /// default context, every noise module generates the same output values as
+        /// without a context. A context holds no state of its own, so each thread
+        /// can evaluate a noise-module graph with its own context.
+        ///
+        /// @see Module::GetValue(const EvalContext&, double, double, double)
+        /// @see Module::GetValues(const EvalContext&, const double*, const double*, const double*, double*, int)
+        struct EvalContext {
+            /// Distance between neighboring input values (e.g., the grid spacing of
+            /// a noise map), or 0.0 if unknown.
+            ///
+            /// The Perlin, Billow and RidgedMulti modules fade out the octaves whose
+            /// lattice cells are smaller than about two samples, and skip them
+            /// entirely once they are smaller than one sample (see GetOctaveWeight()).
+            double sampleSpacing = 0.0;
+
+            /// Counters that the noise modules increment, or nullptr to record no
+            /// statistics. Recording statistics does not change any output value.
+            EvalStats* stats = nullptr;
+
+            /// Returns a copy of this context for input values that are scaled by a
+            /// factor.
+            ///
+            /// @param factor The factor that the input values are multiplied by.
+            [[nodiscard]] EvalContext Scaled(double factor) const noexcept {
+                EvalContext context = *this;
+                context.sampleSpacing *= std::fabs(factor);
+                return context;
+            }
+
+            /// Returns the weight of a noise octave that the samples can resolve.
+            ///
+            /// @param frequency The frequency of the octave, in lattice cells per unit.
+            ///
+            /// @returns 1.0 if the sample spacing is at most LOD_FADE_START lattice
+            /// cells of the octave (or unknown), 0.0 if it is at least LOD_FADE_END
+            /// lattice cells, and a linear fade in between.
+            [[nodiscard]] double GetOctaveWeight(double frequency) const noexcept {
+                const double spacing = sampleSpacing * std::fabs(frequency);
+                if (spacing <= LOD_FADE_START) {
+                    return 1.0;
+                }
+                return std::max(0.0, (LOD_FADE_END - spacing) / (LOD_FADE_END - LOD_FADE_START));
+            }
+
+            /// Computes the weights of the octaves of a fractal noise function.
+            ///
+            /// @param frequency The frequency of the first octave.
+            /// @param lacunarity The frequency multiplier between successive octaves.
+            /// @param octaveCount The number of octaves.
+            /// @param[out] weights Array of @a octaveCount elements that receives
+            /// the weight of each octave (see GetOctaveWeight()).
+            ///
+            /// @returns The number of leading octaves to evaluate; the octaves
+            /// after them have the weight 0.0.
+            int GetOctaveWeights(double frequency, double lacunarity, int octaveCount,
+                double* weights) const noexcept {
+                int activeOctaveCount = 0;
+                double curFrequency = frequency;
+                for (int curOctave = 0; curOctave < octaveCount; ++curOctave) {
+                    weights[curOctave] = GetOctaveWeight(curFrequency);
+                    if (weights[curOctave] > 0.0) {
+                        activeOctaveCount = curOctave + 1;
+                    }
+                    curFrequency *= lacunarity;
+                }
+                return activeOctaveCount;
+            }
+
+            /// Determines if two contexts describe the same sampling, so that they
+            /// yield the same output values; the statistics counters are ignored.
+            [[nodiscard]] bool operator==(const EvalContext& other) const noexcept {
+                return sampleSpacing == other.sampleSpacing;
+            }
+
+            /// Determines if two contexts describe different sampling.
+            [[nodiscard]] bool operator!=(const EvalContext& other) const noexcept {
+                return !(*this == other);
+            }
+        };
+
         /// Abstract base class for all noise modules in libnoise.
         ///
         /// A noise module calculates and outputs a value given a three-dimensional
@@ -92,6 +261,33 @@ namespace noise {
                 : m_sourceModules(static_cast<size_t>(sourceModuleCount), nullptr) {
             }
 
+            /// Copy constructor; the copy is connected to the same source modules.
+            Module(const Module&) = default;
+
+            /// Copy assignment operator; connects this noise module to the source
+            /// modules of the other noise module.
+            Module& operator=(const Module&) = default;
+
+            /// Destructor.
+            virtual ~Module() = default;
+
+            /// Returns a copy of this noise module.
+            ///
+            /// @returns A copy that has the same parameters and is connected to the
+            /// same source modules, or nullptr if this noise module cannot be
+            /// copied.
+            ///
+            /// GraphReplica calls this method to copy every noise module of a graph
+            /// and then connects each copy to the copies of its source modules. All
+            /// built-in noise modules can be copied. The default implementation
+            /// returns nullptr, so a GraphReplica shares a custom noise module
+            /// (and, through it, its source modules) with the original graph unless
+            /// the custom module overrides this method; a custom module that keeps
+            /// mutable state should override it (see CloneAs()).
+            [[nodiscard]] virtual std::unique_ptr<Module> Clone() const {
+                return nullptr;
+            }
+
             /// Returns a reference to a source module connected to this noise module.
             ///
             /// @param index The index value assigned to the source module.
@@ -122,6 +318,142 @@ namespace noise {
             /// @pre All required source modules have been set via SetSourceModule().
             virtual double GetValue(double x, double y, double z) const noexcept = 0;
 
+            /// Generates an output value given the coordinates of the specified
+            /// input value and how the input values are evaluated.
+            ///
+            /// @param context Describes how the input values are evaluated.
+            /// @param x The x-coordinate of the input value.
+            /// @param y The y-coordinate of the input value.
+            /// @param z The z-coordinate of the input value.
+            ///
+            /// @returns The output value.
+            /// @pre All required source modules have been set via SetSourceModule().
+            ///
+            /// The built-in noise modules implement GetValue() without a context by
+            /// calling this method with the default context, and pass the context
+            /// on to their source modules, as GetValues() does. The output value is
+            /// identical to the output value that GetValues() returns for the same
+            /// context. The default implementation ignores the context and calls
+            /// GetValue() without it.
+            virtual double GetValue(const EvalContext& /*context*/, double x, double y, double z) const noexcept {
+                return GetValue(x, y, z);
+            }
+
+            /// Generates output values for a batch of input values.
+            ///
+            /// @param x Array containing the x-coordinates of the input values.
+            /// @param y Array containing the y-coordinates of the input values.
+            /// @param z Array containing the z-coordinates of the input values.
+            /// @param[out] out Array that receives the output values.
+            /// @param count The number of input values in the batch.
+            ///
+            /// @pre All required source modules have been set via SetSourceModule().
+            /// @pre Each array holds at least @a count elements.
+            /// @pre The @a out array does not overlap any of the coordinate arrays.
+            ///
+            /// Each output value is identical to the value that GetValue() returns
+            /// for the same input value. Evaluating a whole batch (e.g., a row of a
+            /// noise map) lets a noise module pay for virtual dispatch once per batch
+            /// instead of once per point. The default implementation calls GetValue()
+            /// for each input value; all built-in noise modules override it.
+            virtual void GetValues(const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept {
+                for (int i = 0; i < count; ++i) {
+                    out[i] = GetValue(x[i], y[i], z[i]);
+                }
+            }
+
+            /// Generates single-precision output values for a batch of
+            /// single-precision input values.
+            ///
+            /// @param x Array containing the x-coordinates of the input values.
+            /// @param y Array containing the y-coordinates of the input values.
+            /// @param z Array containing the z-coordinates of the input values.
+            /// @param[out] out Array that receives the output values.
+            /// @param count The number of input values in the batch.
+            ///
+            /// @pre All required source modules have been set via SetSourceModule().
+            /// @pre Each array holds at least @a count elements.
+            /// @pre The @a out array does not overlap any of the coordinate arrays.
+            ///
+            /// This is the opt-in single-precision evaluation path, intended for
+            /// output that is stored with single precision or less (e.g., noise maps
+            /// and images). The built-in noise modules carry single-precision values
+            /// from module to module, and the Perlin, Billow and RidgedMulti
+            /// generators compute their noise in single precision, which doubles the
+            /// number of values per SIMD instruction. The output values are therefore
+            /// close to, but not identical to, the values that the double-precision
+            /// overload returns; see the documentation of each generator module for
+            /// its accuracy. Near a discontinuity (e.g., the edge of a Select module
+            /// without edge falloff, or a Voronoi cell boundary), a small difference
+            /// can select a different output value. The default implementation
+            /// converts the batch to double precision and calls the double-precision
+            /// overload.
+            virtual void GetValues(const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept {
+                const size_t size = static_cast<size_t>(count);
+                std::vector<double> dx(x, x + size), dy(y, y + size), dz(z, z + size);
+                std::vector<double> values(size);
+                GetValues(dx.data(), dy.data(), dz.data(), values.data(), count);
+                for (size_t i = 0; i < size; ++i) {
+                    out[i] = static_cast<float>(values[i]);
+                }
+            }
+
+            /// Generates output values for a batch of input values, given how the
+            /// input values are sampled.
+            ///
+            /// @param context Describes how the input values are sampled.
+            /// @param x Array containing the x-coordinates of the input values.
+            /// @param y Array containing the y-coordinates of the input values.
+            /// @param z Array containing the z-coordinates of the input values.
+            /// @param[out] out Array that receives the output values.
+            /// @param count The number of input values in the batch.
+            ///
+            /// @pre All required source modules have been set via SetSourceModule().
+            /// @pre Each array holds at least @a count elements.
+            /// @pre The @a out array does not overlap any of the coordinate arrays.
+            ///
+            /// The built-in noise modules pass the context on to their source
+            /// modules, and the fractal generator modules use it to skip octaves
+            /// that the samples cannot resolve (see EvalContext). With the default
+            /// context, the output values are identical to the values that
+            /// GetValues() without a context returns. The default implementation
+            /// ignores the context and calls GetValues() without it.
+            virtual void GetValues(const EvalContext& /*context*/, const double* x, const double* y,
+                const double* z, double* out, int count) const noexcept {
+                GetValues(x, y, z, out, count);
+            }
+
+            /// Generates single-precision output values for a batch of
+            /// single-precision input values, given how the input values are
+            /// sampled.
+            ///
+            /// @see GetValues(const EvalContext&, const double*, const double*, const double*, double*, int)
+            virtual void GetValues(const EvalContext& /*context*/, const float* x, const float* y,
+                const float* z, float* out, int count) const noexcept {
+                GetValues(x, y, z, out, count);
+            }
+
+            /// Returns an interval that contains every output value of this noise module.
+            ///
+            /// @returns The lower and upper bounds of the output values.
+            /// @throw noise::ExceptionNoModule If a required source module is not set.
+            ///
+            /// The bounds are conservative: they are derived from the parameters of
+            /// this noise module and the output ranges of its source modules, so the
+            /// output values may stay well inside them (e.g., the output values of a
+            /// Perlin module with the default parameters rarely leave -1.0 to +1.0,
+            /// although its bounds are wider). Other modules use the bounds to skip
+            /// work, and an application can use them to scale output values (e.g., to
+            /// build a color gradient) without first generating a noise map. The
+            /// bounds apply to the double-precision output values. The default
+            /// implementation returns an unbounded interval; all built-in noise
+            /// modules override it.
+            [[nodiscard]] virtual ValueRange GetValueRange() const {
+                return ValueRange::Unbounded();
+            }
+
             /// Connects a source module to this noise module at the specified index.
             ///
             /// @param index The index value to assign to the source module.
@@ -138,11 +470,149 @@ namespace noise {
                     throw noise::ExceptionInvalidParam();
                 }
                 m_sourceModules[index] = &sourceModule;
+                InvalidateValueRanges();
+            }
+
+            /// Invalidates the decisions that noise modules have derived from the
+            /// output ranges of their source modules (see GetValueRange()).
+            ///
+            /// Select, Max, Min and Clamp use the output ranges of their source
+            /// modules to decide once whether they can skip a source module, and keep
+            /// the decision until this method is called. The built-in noise modules
+            /// call it whenever a change to their parameters or source modules may
+            /// change an output range; a custom noise module whose GetValueRange()
+            /// depends on its parameters must call it from the methods that change
+            /// them.
+            static void InvalidateValueRanges() noexcept {
+                s_valueRangeEpoch.fetch_add(1, std::memory_order_relaxed);
             }
 
         protected:
+            /// A decision that a noise module derives from the output ranges of its
+            /// source modules (e.g., the source module that a Select module always
+            /// selects).
+            ///
+            /// The decision is made on first use and kept until
+            /// InvalidateValueRanges() is called, so the batch path does not walk
+            /// the source modules' graph for each batch. A copy makes its own
+            /// decision. Several threads may use the same object at the same time.
+            class RangeDecision {
+            public:
+                /// Constructor.
+                RangeDecision() noexcept = default;
+
+                /// Copy constructor; the copy makes its own decision.
+                RangeDecision(const RangeDecision&) noexcept {
+                }
+
+                /// Copy assignment operator; discards the decision.
+                RangeDecision& operator=(const RangeDecision&) noexcept {
+                    m_state.store(0, std::memory_order_relaxed);
+                    return *this;
+                }
+
+                /// Returns the decision, making it first if necessary.
+                ///
+                /// @param decide Returns the decision, from -1 to 254.
+                ///
+                /// @returns The decision, or -1 if @a decide throws a noise::Exception
+                /// (e.g., because a source module is not set).
+                template <typename Decide>
+                int Get(Decide decide) const noexcept {
+                    const std::uint64_t epoch = s_valueRangeEpoch.load(std::memory_order_relaxed);
+                    const std::uint64_t state = m_state.load(std::memory_order_relaxed);
+                    if ((state >> 8) == epoch) {
+                        return static_cast<int>(state & 0xFF) - 1;
+                    }
+                    int decision = -1;
+                    try {
+                        decision = decide();
+                    } catch (const noise::Exception&) {
+                        decision = -1;
+                    }
+                    m_state.store((epoch << 8) | static_cast<std::uint64_t>(decision + 1),
+                        std::memory_order_relaxed);
+                    return decision;
+                }
+
+            private:
+                /// The epoch in which the decision was made (see
+                /// InvalidateValueRanges()) above the decision plus one in the low
+                /// eight bits, or 0 if no decision was made.
+                mutable std::atomic<std::uint64_t> m_state{ 0 };
+            };
+
+            /// Implements Clone() for the noise module type T.
+            ///
+            /// @returns A copy of this noise module made by the copy constructor of
+            /// T, or nullptr if the dynamic type of this noise module is not
+            /// exactly T. A subclass of T that does not override Clone() would be
+            /// sliced by that copy constructor, so it is not copied.
+            template <typename T>
+            [[nodiscard]] std::unique_ptr<Module> CloneAs() const {
+                if (typeid(*this) != typeid(T)) {
+                    return nullptr;
+                }
+                return std::make_unique<T>(static_cast<const T&>(*this));
+            }
+
+            /// Number of input values that GetValuesAt() and the combiner modules
+            /// that evaluate their source modules for subsets of a batch (Select,
+            /// Blend) hold in stack storage at a time.
+            static constexpr int GATHER_BLOCK_SIZE = 128;
+
+            /// Generates the output values of a noise module for a subset of a batch
+            /// of input values.
+            ///
+            /// @param module The noise module to evaluate.
+            /// @param context Describes how the input values are sampled.
+            /// @param indices The distinct indices of the input values to evaluate,
+            /// in increasing order.
+            /// @param indexCount The number of indices.
+            /// @param x Array containing the x-coordinates of the input values.
+            /// @param y Array containing the y-coordinates of the input values.
+            /// @param z Array containing the z-coordinates of the input values.
+            /// @param[out] out Array that receives the output value for each index
+            /// in @a indices at that index; other elements are not modified.
+            /// @param count The number of input values in the batch.
+            ///
+            /// The selected input values are gathered into contiguous blocks of up to
+            /// GATHER_BLOCK_SIZE values, so that the noise module evaluates them with
+            /// as few calls to GetValues() as possible instead of interleaving them
+            /// with other calls. If the noise module is a Cache module, the subset
+            /// shares the cached values of any other subset of the same batch.
+            template <typename Real>
+            static void GetValuesAt(const Module& module, const EvalContext& context,
+                const int* indices, int indexCount, const Real* x, const Real* y, const Real* z,
+                Real* out, int count) noexcept {
+                if (indexCount == count) {
+                    module.GetValues(context, x, y, z, out, count);
+                    return;
+                }
+                Real gatheredX[GATHER_BLOCK_SIZE], gatheredY[GATHER_BLOCK_SIZE];
+                Real gatheredZ[GATHER_BLOCK_SIZE], gatheredOut[GATHER_BLOCK_SIZE];
+                for (int start = 0; start < indexCount; start += GATHER_BLOCK_SIZE) {
+                    const int blockCount = std::min(GATHER_BLOCK_SIZE, indexCount - start);
+                    const int* blockIndices = indices + start;
+                    for (int i = 0; i < blockCount; ++i) {
+                        gatheredX[i] = x[blockIndices[i]];
+                        gatheredY[i] = y[blockIndices[i]];
+                        gatheredZ[i] = z[blockIndices[i]];
+                    }
+                    module.GetValues(context, gatheredX, gatheredY, gatheredZ, gatheredOut, blockCount);
+                    for (int i = 0; i < blockCount; ++i) {
+                        out[blockIndices[i]] = gatheredOut[i];
+                    }
+                }
+            }
+
             /// Vector containing pointers to all source modules required by this noise module.
             std::vector<const Module*> m_sourceModules;
+
+        private:
+            /// Counts the calls to InvalidateValueRanges(); starts at 1, so that a
+            /// RangeDecision that was never made does not match.
+            inline static std::atomic<std::uint64_t> s_valueRangeEpoch{ 1 };
         };
 
     } // namespace module
@@ -29,6 +29,7 @@
 #pragma once
 
 #include <cassert>  // For assert
+#include <vector>   // For std::vector
 #include "modulebase.h"
 
 namespace noise {
@@ -49,6 +50,11 @@ namespace noise {
             /// Constructor.
             Multiply() noexcept : Module(GetSourceModuleCount()) {}
 
+            /// @see Module::Clone()
+            [[nodiscard]] std::unique_ptr<Module> Clone() const override {
+                return CloneAs<Multiply>();
+            }
+
             /// Returns the number of source modules required by this noise module.
             ///
             /// @returns Always 2, as this module requires two source modules.
@@ -56,6 +62,15 @@ namespace noise {
                 return 2;
             }
 
+            /// Returns an interval that contains every output value of this noise module.
+            ///
+            /// @returns The product of the output ranges of the source modules.
+            ///
+            /// @see Module::GetValueRange()
+            [[nodiscard]] inline ValueRange GetValueRange() const override {
+                return GetSourceModule(0).GetValueRange().Product(GetSourceModule(1).GetValueRange());
+            }
+
             /// Returns the product of the output values from the two source modules.
             ///
             /// @param x The x-coordinate of the input value.
@@ -65,10 +80,58 @@ namespace noise {
             /// @returns The computed product.
             /// @pre Both source modules (indices 0 and 1) have been set.
             inline double GetValue(double x, double y, double z) const noexcept override {
+                return GetValue(EvalContext(), x, y, z);
+            }
+
+            /// @see Module::GetValue(const EvalContext&, double, double, double)
+            inline double GetValue(const EvalContext& context, double x, double y, double z) const noexcept override {
                 assert(m_sourceModules[0] != nullptr && "Source module 0 must be set before calling GetValue");
                 assert(m_sourceModules[1] != nullptr && "Source module 1 must be set before calling GetValue");
 
-                return m_sourceModules[0]->GetValue(x, y, z) * m_sourceModules[1]->GetValue(x, y, z);
+                return m_sourceModules[0]->GetValue(context, x, y, z) * m_sourceModules[1]->GetValue(context, x, y, z);
+            }
+
+            /// Generates the products of the source modules' output values for a batch
+            /// of input values.
+            ///
+            /// @see Module::GetValues()
+            inline void GetValues(const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(EvalContext(), x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(EvalContext(), x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const EvalContext& context, const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(context, x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const EvalContext& context, const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(context, x, y, z, out, count);
+            }
+
+        private:
+            /// Implements the overloads of GetValues(); Real is double or float.
+            template <typename Real>
+            void GetValuesImpl(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+                Real* out, int count) const noexcept {
+                assert(m_sourceModules[0] != nullptr && "Source module 0 must be set before calling GetValues");
+                assert(m_sourceModules[1] != nullptr && "Source module 1 must be set before calling GetValues");
+
+                std::vector<Real> values1(static_cast<size_t>(count));
+                m_sourceModules[0]->GetValues(context, x, y, z, out, count);
+                m_sourceModules[1]->GetValues(context, x, y, z, values1.data(), count);
+                for (int i = 0; i < count; ++i) {
+                    out[i] *= values1[i];
+                }
             }
         };
 
@@ -28,8 +28,11 @@
 
 #pragma once
 
+#include <algorithm> // For std::min, std::min_element, std::max_element
 #include <cassert>  // For assert
 #include <cmath>    // For std::pow
+#include <vector>   // For std::vector
+#include "../fastpow.h"
 #include "modulebase.h"
 
 namespace noise {
@@ -45,11 +48,37 @@ namespace noise {
         /// - Source module 0 (index 0): The base value.
         /// - Source module 1 (index 1): The exponent value.
         ///
-        /// The output is computed as: pow(source1, source0).
+        /// The output is computed as: pow(source1, source0), by std::pow() unless
+        /// the fast power approximation is enabled (see EnableFastPow()).
         class Power : public Module {
         public:
             /// Constructor.
-            Power() noexcept : Module(GetSourceModuleCount()) {}
+            Power() noexcept : Module(GetSourceModuleCount()), m_isFastPowEnabled(false) {}
+
+            /// Enables or disables the fast power approximation.
+            ///
+            /// @param enable Specifies whether to use the fast power approximation.
+            ///
+            /// If enabled, the powers are evaluated by noise::FastPow() instead of
+            /// std::pow(), four values at a time by GetValues() on processors that
+            /// support AVX2. The result differs from the std::pow() result by a
+            /// relative error of less than FAST_POW_MAX_RELATIVE_ERROR. Disabled by
+            /// default.
+            inline void EnableFastPow(bool enable = true) noexcept {
+                m_isFastPowEnabled = enable;
+            }
+
+            /// Determines if the fast power approximation is enabled.
+            ///
+            /// @returns True if the fast power approximation is enabled, false otherwise.
+            [[nodiscard]] inline bool IsFastPowEnabled() const noexcept {
+                return m_isFastPowEnabled;
+            }
+
+            /// @see Module::Clone()
+            [[nodiscard]] std::unique_ptr<Module> Clone() const override {
+                return CloneAs<Power>();
+            }
 
             /// Returns the number of source modules required by this noise module.
             ///
@@ -58,6 +87,32 @@ namespace noise {
                 return 2;
             }
 
+            /// Returns an interval that contains every output value of this noise module.
+            ///
+            /// @returns The range of the powers if the base (source module 1) is always
+            /// positive; otherwise, an unbounded interval.
+            ///
+            /// @see Module::GetValueRange()
+            [[nodiscard]] inline ValueRange GetValueRange() const override {
+                const ValueRange exponent = GetSourceModule(0).GetValueRange();
+                const ValueRange base = GetSourceModule(1).GetValueRange();
+                if (base.lowerBound <= 0.0) {
+                    return ValueRange::Unbounded();
+                }
+                // For a positive base, the power is monotonic in each argument.
+                const double powers[4] = {
+                    std::pow(base.lowerBound, exponent.lowerBound), std::pow(base.lowerBound, exponent.upperBound),
+                    std::pow(base.upperBound, exponent.lowerBound), std::pow(base.upperBound, exponent.upperBound)
+                };
+                const ValueRange range = { *std::min_element(powers, powers + 4), *std::max_element(powers, powers + 4) };
+                if (!m_isFastPowEnabled) {
+                    return range;
+                }
+                // Widen the bounds to cover the error of the approximation.
+                return { range.lowerBound - FAST_POW_MAX_RELATIVE_ERROR * std::fabs(range.lowerBound),
+                    range.upperBound + FAST_POW_MAX_RELATIVE_ERROR * std::fabs(range.upperBound) };
+            }
+
             /// Returns the result of raising the output of source module 1 to the power
             /// of the output of source module 0.
             ///
@@ -68,13 +123,93 @@ namespace noise {
             /// @returns The computed value.
             /// @pre Both source modules (indices 0 and 1) have been set.
             inline double GetValue(double x, double y, double z) const noexcept override {
+                return GetValue(EvalContext(), x, y, z);
+            }
+
+            /// @see Module::GetValue(const EvalContext&, double, double, double)
+            inline double GetValue(const EvalContext& context, double x, double y, double z) const noexcept override {
                 assert(m_sourceModules[0] != nullptr && "Source module 0 must be set before calling GetValue");
                 assert(m_sourceModules[1] != nullptr && "Source module 1 must be set before calling GetValue");
 
-                const double v0 = m_sourceModules[0]->GetValue(x, y, z);
-                const double v1 = m_sourceModules[1]->GetValue(x, y, z);
-                return std::pow(v1, v0);
+                const double v0 = m_sourceModules[0]->GetValue(context, x, y, z);
+                const double v1 = m_sourceModules[1]->GetValue(context, x, y, z);
+                return m_isFastPowEnabled ? FastPow(v1, v0) : std::pow(v1, v0);
+            }
+
+            /// Generates the values of source module 1 raised to the power of source
+            /// module 0 for a batch of input values.
+            ///
+            /// @see Module::GetValues()
+            inline void GetValues(const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(EvalContext(), x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(EvalContext(), x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const EvalContext& context, const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(context, x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const EvalContext& context, const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(context, x, y, z, out, count);
             }
+
+        private:
+            /// Implements the overloads of GetValues(); Real is double or float.
+            template <typename Real>
+            void GetValuesImpl(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+                Real* out, int count) const noexcept {
+                assert(m_sourceModules[0] != nullptr && "Source module 0 must be set before calling GetValues");
+                assert(m_sourceModules[1] != nullptr && "Source module 1 must be set before calling GetValues");
+
+                std::vector<Real> values1(static_cast<size_t>(count));
+                m_sourceModules[0]->GetValues(context, x, y, z, out, count);
+                m_sourceModules[1]->GetValues(context, x, y, z, values1.data(), count);
+                if (m_isFastPowEnabled) {
+                    ApplyFastPow(values1.data(), out, count);
+                    return;
+                }
+                for (int i = 0; i < count; ++i) {
+                    out[i] = std::pow(values1[i], out[i]);
+                }
+            }
+
+            /// Raises a batch of bases to the powers in @a values using the fast
+            /// power approximation.
+            inline void ApplyFastPow(const double* base, double* values, int count) const noexcept {
+                FastPow(base, values, values, count);
+            }
+
+            /// Single-precision counterpart of ApplyFastPow(); the powers are
+            /// evaluated in double precision.
+            inline void ApplyFastPow(const float* base, float* values, int count) const noexcept {
+                constexpr int BLOCK_SIZE = 256;
+                double baseBlock[BLOCK_SIZE];
+                double block[BLOCK_SIZE];
+                for (int start = 0; start < count; start += BLOCK_SIZE) {
+                    const int blockCount = std::min(BLOCK_SIZE, count - start);
+                    for (int i = 0; i < blockCount; ++i) {
+                        baseBlock[i] = base[start + i];
+                        block[i] = values[start + i];
+                    }
+                    FastPow(baseBlock, block, block, blockCount);
+                    for (int i = 0; i < blockCount; ++i) {
+                        values[start + i] = static_cast<float>(block[i]);
+                    }
+                }
+            }
+
+            /// Determines if the fast power approximation is enabled.
+            bool m_isFastPowEnabled;
         };
 
     } // namespace module
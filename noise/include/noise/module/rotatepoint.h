@@ -34,6 +34,7 @@
 
 #include <cassert>   // For assert
 #include <cmath>     // For std::sin, std::cos
+#include <vector>    // For std::vector
 #include "../mathconsts.h"
 #include "modulebase.h"
 
@@ -71,6 +72,11 @@ namespace noise {
                 SetAngles(DEFAULT_ROTATE_X, DEFAULT_ROTATE_Y, DEFAULT_ROTATE_Z);
             }
 
+            /// @see Module::Clone()
+            [[nodiscard]] std::unique_ptr<Module> Clone() const override {
+                return CloneAs<RotatePoint>();
+            }
+
             /// Returns the number of source modules required by this noise module.
             ///
             /// @returns Always 1, as this module requires one source module.
@@ -78,6 +84,15 @@ namespace noise {
                 return 1;
             }
 
+            /// Returns an interval that contains every output value of this noise module.
+            ///
+            /// @returns The output range of the source module.
+            ///
+            /// @see Module::GetValueRange()
+            [[nodiscard]] inline ValueRange GetValueRange() const override {
+                return GetSourceModule(0).GetValueRange();
+            }
+
             /// Returns the result of rotating the input coordinates and retrieving
             /// the output value from the source module.
             ///
@@ -88,12 +103,44 @@ namespace noise {
             /// @returns The output value from the source module after rotation.
             /// @pre The source module (index 0) has been set.
             inline double GetValue(double x, double y, double z) const noexcept override {
+                return GetValue(EvalContext(), x, y, z);
+            }
+
+            /// @see Module::GetValue(const EvalContext&, double, double, double)
+            inline double GetValue(const EvalContext& context, double x, double y, double z) const noexcept override {
                 assert(m_sourceModules[0] != nullptr && "Source module must be set before calling GetValue");
 
                 double nx = (m_x1Matrix * x) + (m_y1Matrix * y) + (m_z1Matrix * z);
                 double ny = (m_x2Matrix * x) + (m_y2Matrix * y) + (m_z2Matrix * z);
                 double nz = (m_x3Matrix * x) + (m_y3Matrix * y) + (m_z3Matrix * z);
-                return m_sourceModules[0]->GetValue(nx, ny, nz);
+                return m_sourceModules[0]->GetValue(context, nx, ny, nz);
+            }
+
+            /// Returns the output values from the source module at the rotated input
+            /// values for a batch of input values.
+            ///
+            /// @see Module::GetValues()
+            inline void GetValues(const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(EvalContext(), x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(EvalContext(), x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const EvalContext& context, const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(context, x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const EvalContext& context, const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(context, x, y, z, out, count);
             }
 
             /// Returns the rotation angle around the x axis.
@@ -146,6 +193,30 @@ namespace noise {
             }
 
         protected:
+            /// CompiledGraph reads the internal state of this module when it
+            /// flattens a graph that contains it.
+            friend class CompiledGraph;
+
+            /// Implements the overloads of GetValues(); Real is double or float.
+            template <typename Real>
+            void GetValuesImpl(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+                Real* out, int count) const noexcept {
+                assert(m_sourceModules[0] != nullptr && "Source module must be set before calling GetValues");
+
+                const Real x1Matrix = static_cast<Real>(m_x1Matrix), y1Matrix = static_cast<Real>(m_y1Matrix), z1Matrix = static_cast<Real>(m_z1Matrix);
+                const Real x2Matrix = static_cast<Real>(m_x2Matrix), y2Matrix = static_cast<Real>(m_y2Matrix), z2Matrix = static_cast<Real>(m_z2Matrix);
+                const Real x3Matrix = static_cast<Real>(m_x3Matrix), y3Matrix = static_cast<Real>(m_y3Matrix), z3Matrix = static_cast<Real>(m_z3Matrix);
+                std::vector<Real> nx(static_cast<size_t>(count));
+                std::vector<Real> ny(static_cast<size_t>(count));
+                std::vector<Real> nz(static_cast<size_t>(count));
+                for (int i = 0; i < count; ++i) {
+                    nx[i] = (x1Matrix * x[i]) + (y1Matrix * y[i]) + (z1Matrix * z[i]);
+                    ny[i] = (x2Matrix * x[i]) + (y2Matrix * y[i]) + (z2Matrix * z[i]);
+                    nz[i] = (x3Matrix * x[i]) + (y3Matrix * y[i]) + (z3Matrix * z[i]);
+                }
+                m_sourceModules[0]->GetValues(context, nx.data(), ny.data(), nz.data(), out, count);
+            }
+
             /// Entry within the 3x3 rotation matrix used for rotating the input value.
             double m_x1Matrix;
 
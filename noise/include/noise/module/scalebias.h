@@ -77,6 +77,11 @@ namespace noise {
                 return m_scale;
             }
 
+            /// @see Module::Clone()
+            [[nodiscard]] std::unique_ptr<Module> Clone() const override {
+                return CloneAs<ScaleBias>();
+            }
+
             /// Returns the number of source modules required by this noise module.
             ///
             /// @returns Always 1, as this module requires one source module.
@@ -84,6 +89,16 @@ namespace noise {
                 return 1;
             }
 
+            /// Returns an interval that contains every output value of this noise module.
+            ///
+            /// @returns The output range of the source module, scaled and biased.
+            ///
+            /// @see Module::GetValueRange()
+            [[nodiscard]] inline ValueRange GetValueRange() const override {
+                const ValueRange scaled = GetSourceModule(0).GetValueRange().Product({ m_scale, m_scale });
+                return { scaled.lowerBound + m_bias, scaled.upperBound + m_bias };
+            }
+
             /// Returns the scaled and biased output value from the source module.
             ///
             /// @param x The x-coordinate of the input value.
@@ -93,8 +108,40 @@ namespace noise {
             /// @returns The scaled and biased output value.
             /// @pre The source module (index 0) has been set.
             inline double GetValue(double x, double y, double z) const noexcept override {
+                return GetValue(EvalContext(), x, y, z);
+            }
+
+            /// @see Module::GetValue(const EvalContext&, double, double, double)
+            inline double GetValue(const EvalContext& context, double x, double y, double z) const noexcept override {
                 assert(m_sourceModules[0] != nullptr && "Source module must be set before calling GetValue");
-                return m_sourceModules[0]->GetValue(x, y, z) * m_scale + m_bias;
+                return m_sourceModules[0]->GetValue(context, x, y, z) * m_scale + m_bias;
+            }
+
+            /// Generates the scaled and biased output values from the source module for
+            /// a batch of input values.
+            ///
+            /// @see Module::GetValues()
+            inline void GetValues(const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(EvalContext(), x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(EvalContext(), x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const EvalContext& context, const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(context, x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const EvalContext& context, const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(context, x, y, z, out, count);
             }
 
             /// Sets the bias to apply to the scaled output value.
@@ -102,6 +149,7 @@ namespace noise {
             /// @param bias The bias to apply.
             inline void SetBias(double bias) noexcept {
                 m_bias = bias;
+                InvalidateValueRanges();
             }
 
             /// Sets the scaling factor to apply to the output value.
@@ -109,9 +157,23 @@ namespace noise {
             /// @param scale The scaling factor to apply.
             inline void SetScale(double scale) noexcept {
                 m_scale = scale;
+                InvalidateValueRanges();
             }
 
         protected:
+            /// Implements the overloads of GetValues(); Real is double or float.
+            template <typename Real>
+            void GetValuesImpl(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+                Real* out, int count) const noexcept {
+                assert(m_sourceModules[0] != nullptr && "Source module must be set before calling GetValues");
+                const Real scale = static_cast<Real>(m_scale);
+                const Real bias = static_cast<Real>(m_bias);
+                m_sourceModules[0]->GetValues(context, x, y, z, out, count);
+                for (int i = 0; i < count; ++i) {
+                    out[i] = out[i] * scale + bias;
+                }
+            }
+
             /// Bias to apply to the scaled output value from the source module.
             double m_bias;
 
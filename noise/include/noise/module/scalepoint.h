@@ -30,7 +30,10 @@
 
 #pragma once
 
+#include <algorithm> // For std::max
 #include <cassert>  // For assert
+#include <cmath>    // For std::fabs
+#include <vector>   // For std::vector
 #include "modulebase.h"
 
 namespace noise {
@@ -67,6 +70,11 @@ namespace noise {
                 m_zScale(DEFAULT_SCALE_POINT_Z) {
             }
 
+            /// @see Module::Clone()
+            [[nodiscard]] std::unique_ptr<Module> Clone() const override {
+                return CloneAs<ScalePoint>();
+            }
+
             /// Returns the number of source modules required by this noise module.
             ///
             /// @returns Always 1, as this module requires one source module.
@@ -74,6 +82,15 @@ namespace noise {
                 return 1;
             }
 
+            /// Returns an interval that contains every output value of this noise module.
+            ///
+            /// @returns The output range of the source module.
+            ///
+            /// @see Module::GetValueRange()
+            [[nodiscard]] inline ValueRange GetValueRange() const override {
+                return GetSourceModule(0).GetValueRange();
+            }
+
             /// Returns the scaled output value from the source module.
             ///
             /// @param x The x-coordinate of the input value.
@@ -83,8 +100,43 @@ namespace noise {
             /// @returns The scaled output value.
             /// @pre The source module (index 0) has been set.
             inline double GetValue(double x, double y, double z) const noexcept override {
+                return GetValue(EvalContext(), x, y, z);
+            }
+
+            /// @see Module::GetValue(const EvalContext&, double, double, double)
+            inline double GetValue(const EvalContext& context, double x, double y, double z) const noexcept override {
                 assert(m_sourceModules[0] != nullptr && "Source module must be set before calling GetValue");
-                return m_sourceModules[0]->GetValue(x * m_xScale, y * m_yScale, z * m_zScale);
+                // As in GetValues(), the samples are spaced apart by up to the largest
+                // scaling factor.
+                const double maxScale = std::max({ std::fabs(m_xScale), std::fabs(m_yScale), std::fabs(m_zScale) });
+                return m_sourceModules[0]->GetValue(context.Scaled(maxScale), x * m_xScale, y * m_yScale, z * m_zScale);
+            }
+
+            /// Returns the output values from the source module at the scaled input
+            /// values for a batch of input values.
+            ///
+            /// @see Module::GetValues()
+            inline void GetValues(const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(EvalContext(), x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(EvalContext(), x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const EvalContext& context, const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(context, x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const EvalContext& context, const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(context, x, y, z, out, count);
             }
 
             /// Returns the scaling factor applied to the x coordinate.
@@ -150,6 +202,28 @@ namespace noise {
             }
 
         protected:
+            /// Implements the overloads of GetValues(); Real is double or float.
+            template <typename Real>
+            void GetValuesImpl(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+                Real* out, int count) const noexcept {
+                assert(m_sourceModules[0] != nullptr && "Source module must be set before calling GetValues");
+
+                const Real xScale = static_cast<Real>(m_xScale);
+                const Real yScale = static_cast<Real>(m_yScale);
+                const Real zScale = static_cast<Real>(m_zScale);
+                std::vector<Real> nx(static_cast<size_t>(count));
+                std::vector<Real> ny(static_cast<size_t>(count));
+                std::vector<Real> nz(static_cast<size_t>(count));
+                for (int i = 0; i < count; ++i) {
+                    nx[i] = x[i] * xScale;
+                    ny[i] = y[i] * yScale;
+                    nz[i] = z[i] * zScale;
+                }
+                // The samples are spaced apart by up to the largest scaling factor.
+                const double maxScale = std::max({ std::fabs(m_xScale), std::fabs(m_yScale), std::fabs(m_zScale) });
+                m_sourceModules[0]->GetValues(context.Scaled(maxScale), nx.data(), ny.data(), nz.data(), out, count);
+            }
+
             /// Scaling factor applied to the x coordinate of the input value.
             double m_xScale;
 
@@ -60,6 +60,12 @@ namespace noise {
         /// SetBounds()), this module outputs the value from source module 1; otherwise,
         /// it outputs the value from source module 0. The edge transition can be smoothed
         /// by setting an edge falloff value with SetEdgeFalloff().
+        ///
+        /// If the output range of the control module (see GetValueRange()) shows
+        /// that it always selects the same source module, GetValues() evaluates
+        /// only that source module and skips the control module. The range is
+        /// checked on the first batch and again only after a change to a noise
+        /// module (see Module::InvalidateValueRanges()).
         class Select : public Module {
         public:
             /// Constructor.
@@ -93,6 +99,11 @@ namespace noise {
                 return m_lowerBound;
             }
 
+            /// @see Module::Clone()
+            [[nodiscard]] std::unique_ptr<Module> Clone() const override {
+                return CloneAs<Select>();
+            }
+
             /// Returns the number of source modules required by this noise module.
             ///
             /// @returns Always 3, as this module requires three source modules.
@@ -100,6 +111,14 @@ namespace noise {
                 return 3;
             }
 
+            /// Returns an interval that contains every output value of this noise module.
+            ///
+            /// @returns The output range of each source module that the control
+            /// module's output range can select.
+            ///
+            /// @see Module::GetValueRange()
+            [[nodiscard]] ValueRange GetValueRange() const override;
+
             /// Returns the upper bound of the selection range.
             ///
             /// @returns The upper bound of the selection range.
@@ -109,6 +128,34 @@ namespace noise {
 
             double GetValue(double x, double y, double z) const noexcept override;
 
+            /// @see Module::GetValue(const EvalContext&, double, double, double)
+            double GetValue(const EvalContext& context, double x, double y, double z) const noexcept override;
+
+            /// Generates output values for a batch of input values.
+            ///
+            /// The batch is evaluated in blocks of up to GATHER_BLOCK_SIZE input
+            /// values. The control module is evaluated for the whole block; each
+            /// point then evaluates only the source module(s) that its control value
+            /// selects. Each source module therefore receives a subset of the block; a source
+            /// module that is shared with other noise modules should be wrapped in a
+            /// Cache module, which evaluates each input value once for all subsets.
+            ///
+            /// @see Module::GetValues()
+            void GetValues(const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override;
+
+            /// @see Module::GetValues()
+            void GetValues(const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override;
+
+            /// @see Module::GetValues()
+            void GetValues(const EvalContext& context, const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override;
+
+            /// @see Module::GetValues()
+            void GetValues(const EvalContext& context, const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override;
+
             /// Sets the lower and upper bounds of the selection range.
             ///
             /// @param lowerBound The lower bound.
@@ -129,6 +176,7 @@ namespace noise {
             inline void SetControlModule(const Module& controlModule) noexcept {
                 assert(m_sourceModules.size() >= 3);
                 m_sourceModules[2] = &controlModule;
+                InvalidateValueRanges();
             }
 
             /// Sets the falloff value at the edge transition.
@@ -141,6 +189,71 @@ namespace noise {
             void SetEdgeFalloff(double edgeFalloff) noexcept;
 
         protected:
+            /// CompiledGraph reads the internal state of this module when it
+            /// flattens a graph that contains it.
+            friend class CompiledGraph;
+
+            /// Implements the overloads of GetValues(); Real is double or float.
+            template <typename Real>
+            void GetValuesImpl(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+                Real* out, int count) const noexcept;
+
+            /// Returns the source module that GetValue() outputs unchanged for
+            /// every control value in a range.
+            ///
+            /// @param controlRange A range of output values from the control module.
+            ///
+            /// @returns The index of the selected source module, or -1 if the
+            /// range crosses an edge of the selection range or its edge falloff.
+            [[nodiscard]] int GetSelectedSource(const ValueRange& controlRange) const noexcept;
+
+            /// Returns the output value selected by a control value.
+            ///
+            /// @param context The evaluation context of the source modules.
+            /// @param controlValue The output value from the control module at the input value.
+            /// @param x The x-coordinate of the input value.
+            /// @param y The y-coordinate of the input value.
+            /// @param z The z-coordinate of the input value.
+            ///
+            /// @returns The output value from the selected source module(s).
+            double GetSelectedValue(const EvalContext& context, double controlValue,
+                double x, double y, double z) const noexcept;
+
+            /// Source modules that an output value is taken from.
+            enum class SelectionRegion : unsigned char {
+                /// The output value from source module 0.
+                Source0,
+                /// The output value from source module 1.
+                Source1,
+                /// The lower edge transition, from source module 0 to source module 1.
+                LowerEdge,
+                /// The upper edge transition, from source module 1 to source module 0.
+                UpperEdge
+            };
+
+            /// Returns the source modules that a control value selects.
+            ///
+            /// @param controlValue The output value from the control module.
+            /// @param[out] alpha Receives the weight of the source module that an
+            /// edge transition leads to, if the control value lies within one.
+            ///
+            /// @returns The region of the control value. An edge transition whose
+            /// weight is exactly 0.0 or 1.0 selects one source module outright, so
+            /// that the other source module need not be evaluated.
+            SelectionRegion GetSelectionRegion(double controlValue, double& alpha) const noexcept;
+
+            /// Returns the output value for a region, given the output values from
+            /// the source modules that it selects.
+            ///
+            /// @param region The region returned by GetSelectionRegion().
+            /// @param alpha The weight returned by GetSelectionRegion().
+            /// @param value0 The output value from source module 0, if selected.
+            /// @param value1 The output value from source module 1, if selected.
+            ///
+            /// @returns The selected or blended output value.
+            static double GetRegionValue(SelectionRegion region, double alpha,
+                double value0, double value1) noexcept;
+
             /// Edge-falloff value.
             double m_edgeFalloff;
 
@@ -149,6 +262,10 @@ namespace noise {
 
             /// Upper bound of the selection range.
             double m_upperBound;
+
+            /// The source module that the output range of the control module
+            /// selects (see GetSelectedSource()).
+            RangeDecision m_selectedSource;
         };
 
     } // namespace module
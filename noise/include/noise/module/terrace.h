@@ -79,6 +79,7 @@ namespace noise {
             /// Deletes all control points on the terrace-forming curve.
             inline void ClearAllControlPoints() noexcept {
                 m_controlPoints.clear();
+                InvalidateValueRanges();
             }
 
             /// Returns a pointer to the array of control points.
@@ -98,6 +99,11 @@ namespace noise {
                 return static_cast<int>(m_controlPoints.size());
             }
 
+            /// @see Module::Clone()
+            [[nodiscard]] std::unique_ptr<Module> Clone() const override {
+                return CloneAs<Terrace>();
+            }
+
             /// Returns the number of source modules required by this noise module.
             ///
             /// @returns Always 1, as this module requires one source module.
@@ -105,11 +111,20 @@ namespace noise {
                 return 1;
             }
 
+            /// Returns an interval that contains every output value of this noise module.
+            ///
+            /// @returns The range of the terrace-forming curve over the output range of
+            /// the source module.
+            ///
+            /// @see Module::GetValueRange()
+            [[nodiscard]] ValueRange GetValueRange() const override;
+
             /// Enables or disables inversion of the terrace-forming curve.
             ///
             /// @param invert Specifies whether to invert the curve (default: true).
             inline void InvertTerraces(bool invert = true) noexcept {
                 m_invertTerraces = invert;
+                InvalidateValueRanges();
             }
 
             /// Determines if the terrace-forming curve is inverted.
@@ -121,6 +136,28 @@ namespace noise {
 
             double GetValue(double x, double y, double z) const noexcept override;
 
+            /// @see Module::GetValue(const EvalContext&, double, double, double)
+            double GetValue(const EvalContext& context, double x, double y, double z) const noexcept override;
+
+            /// Maps the source module's output values onto the terrace-forming curve
+            /// for a batch of input values.
+            ///
+            /// @see Module::GetValues()
+            void GetValues(const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override;
+
+            /// @see Module::GetValues()
+            void GetValues(const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override;
+
+            /// @see Module::GetValues()
+            void GetValues(const EvalContext& context, const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override;
+
+            /// @see Module::GetValues()
+            void GetValues(const EvalContext& context, const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override;
+
             /// Creates equally-spaced control points ranging from -1 to +1.
             ///
             /// @param controlPointCount The number of control points to generate.
@@ -129,6 +166,15 @@ namespace noise {
             void MakeControlPoints(int controlPointCount);
 
         protected:
+            /// CompiledGraph reads the internal state of this module when it
+            /// flattens a graph that contains it.
+            friend class CompiledGraph;
+
+            /// Implements the overloads of GetValues(); Real is double or float.
+            template <typename Real>
+            void GetValuesImpl(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+                Real* out, int count) const noexcept;
+
             /// Determines the position to insert a new control point.
             ///
             /// @param value The value of the control point.
@@ -144,6 +190,13 @@ namespace noise {
             /// @param value The value of the control point.
             void InsertAtPos(int insertionPos, double value);
 
+            /// Maps an output value from the source module onto the terrace-forming curve.
+            ///
+            /// @param sourceModuleValue The output value from the source module.
+            ///
+            /// @returns The mapped output value.
+            double MapSourceValue(double sourceModuleValue) const noexcept;
+
             /// Vector that stores the control points in sorted order.
             std::vector<double> m_controlPoints;
 
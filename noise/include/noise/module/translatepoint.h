@@ -31,6 +31,7 @@
 #pragma once
 
 #include <cassert>  // For assert
+#include <vector>   // For std::vector
 #include "modulebase.h"
 
 namespace noise {
@@ -68,6 +69,11 @@ namespace noise {
                 m_zTranslation(DEFAULT_TRANSLATE_POINT_Z) {
             }
 
+            /// @see Module::Clone()
+            [[nodiscard]] std::unique_ptr<Module> Clone() const override {
+                return CloneAs<TranslatePoint>();
+            }
+
             /// Returns the number of source modules required by this noise module.
             ///
             /// @returns Always 1, as this module requires one source module.
@@ -75,6 +81,15 @@ namespace noise {
                 return 1;
             }
 
+            /// Returns an interval that contains every output value of this noise module.
+            ///
+            /// @returns The output range of the source module.
+            ///
+            /// @see Module::GetValueRange()
+            [[nodiscard]] inline ValueRange GetValueRange() const override {
+                return GetSourceModule(0).GetValueRange();
+            }
+
             /// Returns the translated output value from the source module.
             ///
             /// @param x The x-coordinate of the input value.
@@ -84,8 +99,40 @@ namespace noise {
             /// @returns The translated output value.
             /// @pre The source module (index 0) has been set.
             inline double GetValue(double x, double y, double z) const noexcept override {
+                return GetValue(EvalContext(), x, y, z);
+            }
+
+            /// @see Module::GetValue(const EvalContext&, double, double, double)
+            inline double GetValue(const EvalContext& context, double x, double y, double z) const noexcept override {
                 assert(m_sourceModules[0] != nullptr && "Source module must be set before calling GetValue");
-                return m_sourceModules[0]->GetValue(x + m_xTranslation, y + m_yTranslation, z + m_zTranslation);
+                return m_sourceModules[0]->GetValue(context, x + m_xTranslation, y + m_yTranslation, z + m_zTranslation);
+            }
+
+            /// Returns the output values from the source module at the translated input
+            /// values for a batch of input values.
+            ///
+            /// @see Module::GetValues()
+            inline void GetValues(const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(EvalContext(), x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(EvalContext(), x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const EvalContext& context, const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override {
+                GetValuesImpl(context, x, y, z, out, count);
+            }
+
+            /// @see Module::GetValues()
+            inline void GetValues(const EvalContext& context, const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override {
+                GetValuesImpl(context, x, y, z, out, count);
             }
 
             /// Returns the translation amount applied to the x coordinate.
@@ -151,6 +198,26 @@ namespace noise {
             }
 
         protected:
+            /// Implements the overloads of GetValues(); Real is double or float.
+            template <typename Real>
+            void GetValuesImpl(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+                Real* out, int count) const noexcept {
+                assert(m_sourceModules[0] != nullptr && "Source module must be set before calling GetValues");
+
+                const Real xTranslation = static_cast<Real>(m_xTranslation);
+                const Real yTranslation = static_cast<Real>(m_yTranslation);
+                const Real zTranslation = static_cast<Real>(m_zTranslation);
+                std::vector<Real> nx(static_cast<size_t>(count));
+                std::vector<Real> ny(static_cast<size_t>(count));
+                std::vector<Real> nz(static_cast<size_t>(count));
+                for (int i = 0; i < count; ++i) {
+                    nx[i] = x[i] + xTranslation;
+                    ny[i] = y[i] + yTranslation;
+                    nz[i] = z[i] + zTranslation;
+                }
+                m_sourceModules[0]->GetValues(context, nx.data(), ny.data(), nz.data(), out, count);
+            }
+
             /// Translation amount applied to the x coordinate of the input value.
             double m_xTranslation;
 
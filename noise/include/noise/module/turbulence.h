@@ -121,6 +121,11 @@ namespace noise {
                 return m_xDistortModule.GetSeed();
             }
 
+            /// @see Module::Clone()
+            [[nodiscard]] std::unique_ptr<Module> Clone() const override {
+                return CloneAs<Turbulence>();
+            }
+
             /// Returns the number of source modules required by this noise module.
             ///
             /// @returns Always 1, as this module requires one source module.
@@ -128,7 +133,21 @@ namespace noise {
                 return 1;
             }
 
+            /// Returns an interval that contains every output value of this noise module.
+            ///
+            /// @returns The output range of the source module.
+            ///
+            /// @see Module::GetValueRange()
+            [[nodiscard]] inline ValueRange GetValueRange() const override {
+                return GetSourceModule(0).GetValueRange();
+            }
+
             inline double GetValue(double x, double y, double z) const noexcept override {
+                return GetValue(EvalContext(), x, y, z);
+            }
+
+            /// @see Module::GetValue(const EvalContext&, double, double, double)
+            inline double GetValue(const EvalContext& context, double x, double y, double z) const noexcept override {
                 assert(m_sourceModules[0] != nullptr && "Source module must be set before calling GetValue");
 
                 double x0 = x + (12414.0 / 65536.0);
@@ -141,13 +160,37 @@ namespace noise {
                 double y2 = y + (11213.0 / 65536.0);
                 double z2 = z + (44845.0 / 65536.0);
 
-                double xDistort = x + (m_xDistortModule.GetValue(x0, y0, z0) * m_power);
-                double yDistort = y + (m_yDistortModule.GetValue(x1, y1, z1) * m_power);
-                double zDistort = z + (m_zDistortModule.GetValue(x2, y2, z2) * m_power);
+                double xDistort = x + (m_xDistortModule.GetValue(context, x0, y0, z0) * m_power);
+                double yDistort = y + (m_yDistortModule.GetValue(context, x1, y1, z1) * m_power);
+                double zDistort = z + (m_zDistortModule.GetValue(context, x2, y2, z2) * m_power);
 
-                return m_sourceModules[0]->GetValue(xDistort, yDistort, zDistort);
+                return m_sourceModules[0]->GetValue(context, xDistort, yDistort, zDistort);
             }
 
+            /// Returns the output values from the source module at the randomly
+            /// displaced input values for a batch of input values.
+            ///
+            /// The three distortion modules are evaluated in one octave loop: the
+            /// octaves of the modules that share a seed are passed to the batch
+            /// gradient-coherent-noise function as one batch. The output values are
+            /// identical to the output values of GetValue().
+            ///
+            /// @see Module::GetValues()
+            void GetValues(const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override;
+
+            /// @see Module::GetValues()
+            void GetValues(const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override;
+
+            /// @see Module::GetValues()
+            void GetValues(const EvalContext& context, const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override;
+
+            /// @see Module::GetValues()
+            void GetValues(const EvalContext& context, const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override;
+
             /// Sets the frequency of the turbulence.
             ///
             /// @param frequency The frequency of the turbulence.
@@ -183,6 +226,38 @@ namespace noise {
             void SetSeed(int seed) noexcept;
 
         protected:
+            /// CompiledGraph reads the internal state of this module when it
+            /// flattens a graph that contains it.
+            friend class CompiledGraph;
+
+            /// Implements the overloads of GetValues(); Real is double or float.
+            template <typename Real>
+            void GetValuesImpl(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+                Real* out, int count) const noexcept;
+
+            /// Displaces a batch of input values by the scaled output values of the
+            /// three distortion modules.
+            ///
+            /// @param context The evaluation context of the distortion modules.
+            /// @param x Array containing the x-coordinates of the input values.
+            /// @param y Array containing the y-coordinates of the input values.
+            /// @param z Array containing the z-coordinates of the input values.
+            /// @param[out] xDistort Array that receives the displaced x-coordinates.
+            /// @param[out] yDistort Array that receives the displaced y-coordinates.
+            /// @param[out] zDistort Array that receives the displaced z-coordinates.
+            /// @param count The number of input values.
+            ///
+            /// Each output array may be the corresponding input array.
+            template <typename Real>
+            void GetDistortedValues(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+                Real* xDistort, Real* yDistort, Real* zDistort, int count) const noexcept;
+
+            /// Implements GetDistortedValues() for the noise quality Q of the
+            /// distortion modules.
+            template <NoiseQuality Q, typename Real>
+            void CalcDistortedValues(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+                Real* xDistort, Real* yDistort, Real* zDistort, int count) const noexcept;
+
             /// The power (scale) of the displacement.
             double m_power;
 
@@ -89,6 +89,7 @@ namespace noise {
             /// point. With a near-zero displacement, this can produce cracked-mud formations.
             inline void EnableDistance(bool enable = true) noexcept {
                 m_enableDistance = enable;
+                InvalidateValueRanges();
             }
 
             /// Returns the displacement value of the Voronoi cells.
@@ -111,6 +112,11 @@ namespace noise {
                 return m_frequency;
             }
 
+            /// @see Module::Clone()
+            [[nodiscard]] std::unique_ptr<Module> Clone() const override {
+                return CloneAs<Voronoi>();
+            }
+
             /// Returns the number of source modules required by this noise module.
             ///
             /// @returns Always 0, as this module does not require any source modules.
@@ -118,6 +124,13 @@ namespace noise {
                 return 0;
             }
 
+            /// Returns an interval that contains every output value of this noise module.
+            ///
+            /// @returns The range of the distance value plus or minus the displacement.
+            ///
+            /// @see Module::GetValueRange()
+            [[nodiscard]] ValueRange GetValueRange() const override;
+
             /// Returns the seed value used by the Voronoi cells.
             ///
             /// @returns The seed value.
@@ -138,6 +151,26 @@ namespace noise {
 
             double GetValue(double x, double y, double z) const noexcept override;
 
+            /// Generates output values for a batch of input values.
+            ///
+            /// Each output value is identical to the value that GetValue() returns
+            /// for the same input value. Input values that lie in the same unit cube
+            /// share the seed points of the searched cubes, and on x86 processors
+            /// several of them are compared with each seed point at once using AVX2
+            /// or SSE4.1, selected at run time as for the batch gradient-noise
+            /// functions. Batches that follow a row of input values benefit most.
+            ///
+            /// @see Module::GetValues()
+            void GetValues(const double* x, const double* y, const double* z,
+                double* out, int count) const noexcept override;
+
+            /// @see Module::GetValues()
+            void GetValues(const float* x, const float* y, const float* z,
+                float* out, int count) const noexcept override;
+
+            using Module::GetValue;
+            using Module::GetValues;
+
             /// Sets the displacement value of the Voronoi cells.
             ///
             /// @param displacement The displacement value.
@@ -146,6 +179,7 @@ namespace noise {
             /// cell, spanning +/- the displacement value.
             inline void SetDisplacement(double displacement) noexcept {
                 m_displacement = displacement;
+                InvalidateValueRanges();
             }
 
             /// Sets the frequency of the seed points.
@@ -169,6 +203,16 @@ namespace noise {
             }
 
         protected:
+            /// Returns the output value at a scaled input value, given the nearest
+            /// seed point.
+            double CalcValue(double x, double y, double z,
+                double xCandidate, double yCandidate, double zCandidate) const noexcept;
+
+            /// Implements both overloads of GetValues(); Real is double or float.
+            template <typename Real>
+            void GetValuesImpl(const Real* x, const Real* y, const Real* z,
+                Real* out, int count) const noexcept;
+
             /// Scale of the random displacement to apply to each Voronoi cell.
             double m_displacement;
 
@@ -32,6 +32,17 @@ namespace noise {
     /// @addtogroup libnoise
     /// @{
 
+    /// A bound on the magnitude of every value that the gradient-coherent-noise
+    /// functions return.
+    ///
+    /// The documented range of -1.0 to +1.0 is typical, not strict. A
+    /// gradient-coherent-noise value interpolates the products of unit-length
+    /// gradient vectors with the offsets from the surrounding lattice points,
+    /// scaled by 2.12. The interpolation weights bound the mean squared offset
+    /// length by 3/4, so no value exceeds 2.12 * sqrt(3) / 2 (about 1.836) in
+    /// magnitude. Noise modules use this bound to compute their output ranges.
+    inline constexpr double GRADIENT_NOISE_BOUND = 1.84;
+
     /// Generates a gradient-coherent-noise value from the coordinates of a
     /// three-dimensional input value.
     ///
@@ -48,6 +59,202 @@ namespace noise {
     [[nodiscard]] double GradientCoherentNoise3D(double x, double y, double z, int32 seed = 0,
         NoiseQuality noiseQuality = NoiseQuality::QUALITY_STD) noexcept;
 
+    /// Generates a gradient-coherent-noise value from the coordinates of a
+    /// three-dimensional input value, using a noise quality that is fixed at
+    /// compile time.
+    ///
+    /// @tparam Q The quality of the coherent-noise.
+    ///
+    /// @param x The @a x coordinate of the input value.
+    /// @param y The @a y coordinate of the input value.
+    /// @param z The @a z coordinate of the input value.
+    /// @param seed The random number seed.
+    ///
+    /// @returns The generated gradient-coherent-noise value, ranging from -1.0 to +1.0.
+    ///
+    /// This function returns the same value as GradientCoherentNoise3D()
+    /// called with @a Q as the noise quality. It does not branch on the noise
+    /// quality, and its S-curve is inlined, so loops that evaluate many values
+    /// of the same quality (e.g., the octave loop of a generator module)
+    /// should select the quality once and call this function. It is defined
+    /// for all three NoiseQuality values.
+    template <NoiseQuality Q>
+    [[nodiscard]] double GradientCoherentNoise3D(double x, double y, double z, int32 seed = 0) noexcept;
+
+    /// Generates a gradient-coherent-noise value and its partial derivatives
+    /// from the coordinates of a three-dimensional input value.
+    ///
+    /// @param x The @a x coordinate of the input value.
+    /// @param y The @a y coordinate of the input value.
+    /// @param z The @a z coordinate of the input value.
+    /// @param[out] dx Receives the partial derivative of the value with respect to @a x.
+    /// @param[out] dy Receives the partial derivative of the value with respect to @a y.
+    /// @param[out] dz Receives the partial derivative of the value with respect to @a z.
+    /// @param seed The random number seed.
+    /// @param noiseQuality The quality of the coherent-noise.
+    ///
+    /// @returns The generated gradient-coherent-noise value, ranging from -1.0 to +1.0.
+    ///
+    /// The returned value is identical to the value that
+    /// GradientCoherentNoise3D(x, y, z, seed, noiseQuality) returns. The
+    /// derivatives are computed analytically in the same pass, which costs far
+    /// less than estimating them with finite differences. With
+    /// NoiseQuality::QUALITY_FAST, the derivatives are discontinuous at
+    /// integer boundaries.
+    [[nodiscard]] double GradientCoherentNoise3D(double x, double y, double z,
+        double& dx, double& dy, double& dz, int32 seed = 0,
+        NoiseQuality noiseQuality = NoiseQuality::QUALITY_STD) noexcept;
+
+    /// Generates a gradient-coherent-noise value and its partial derivatives,
+    /// using a noise quality that is fixed at compile time.
+    ///
+    /// @tparam Q The quality of the coherent-noise.
+    ///
+    /// @see GradientCoherentNoise3D(double, double, double, double&, double&, double&, int32, NoiseQuality)
+    template <NoiseQuality Q>
+    [[nodiscard]] double GradientCoherentNoise3D(double x, double y, double z,
+        double& dx, double& dy, double& dz, int32 seed = 0) noexcept;
+
+    /// Generates gradient-coherent-noise values for a batch of
+    /// three-dimensional input values.
+    ///
+    /// @param x Array containing the @a x coordinates of the input values.
+    /// @param y Array containing the @a y coordinates of the input values.
+    /// @param z Array containing the @a z coordinates of the input values.
+    /// @param[out] out Array that receives the generated values.
+    /// @param count The number of input values.
+    /// @param seed The random number seed.
+    /// @param noiseQuality The quality of the coherent-noise.
+    ///
+    /// @pre Each array holds at least @a count elements.
+    /// @pre Each coordinate can be cast to a noise::int32 value (see MakeInt32Range()).
+    ///
+    /// Each output value is identical to the value that the single-point
+    /// GradientCoherentNoise3D() returns for the same input value. On x86
+    /// processors, this function evaluates several input values at once using
+    /// AVX2 (four values per instruction) or SSE4.1 (two values per instruction);
+    /// the instruction set is selected at run time from the features the
+    /// processor reports. The single-point function remains the reference
+    /// implementation and is used on all other processors, for the remainder
+    /// of a batch, and when libnoise is built with NOISE_NO_SIMD defined.
+    ///
+    /// Input values that are consecutive in the arrays and lie in the same
+    /// cube of the integer lattice share the hashes and gradient vectors of the
+    /// cube's vertices; with AVX2, the vertices are hashed once and their
+    /// gradient vectors reused while the input values stay in that cube. Rows
+    /// of closely spaced input values, such as the rows of a noise map at low
+    /// frequencies, are therefore evaluated considerably faster than scattered
+    /// input values.
+    void GradientCoherentNoise3D(const double* x, const double* y, const double* z,
+        double* out, int count, int32 seed = 0,
+        NoiseQuality noiseQuality = NoiseQuality::QUALITY_STD) noexcept;
+
+    /// Generates single-precision gradient-coherent-noise values for a batch
+    /// of three-dimensional input values.
+    ///
+    /// @param x Array containing the @a x coordinates of the input values.
+    /// @param y Array containing the @a y coordinates of the input values.
+    /// @param z Array containing the @a z coordinates of the input values.
+    /// @param[out] out Array that receives the generated values.
+    /// @param count The number of input values.
+    /// @param seed The random number seed.
+    /// @param noiseQuality The quality of the coherent-noise.
+    ///
+    /// @pre Each array holds at least @a count elements.
+    /// @pre Each coordinate can be cast to a noise::int32 value (see MakeInt32Range()).
+    ///
+    /// This function uses the same lattice, hash, and gradient vectors as the
+    /// double-precision function, but performs all floating-point arithmetic
+    /// in single precision, so twice as many values fit in each SIMD register
+    /// (eight with AVX2, four with SSE4.1). For the same input value, the
+    /// result differs from the double-precision result by less than 1.0e-5.
+    /// Note that a single-precision coordinate of magnitude m is itself only
+    /// accurate to about m * 6.0e-8, so callers that scale coordinates in
+    /// single precision should keep them small relative to the feature size.
+    void GradientCoherentNoise3D(const float* x, const float* y, const float* z,
+        float* out, int count, int32 seed = 0,
+        NoiseQuality noiseQuality = NoiseQuality::QUALITY_STD) noexcept;
+
+    /// Generates gradient-coherent-noise values for a batch of
+    /// three-dimensional input values, using a noise quality that is fixed at
+    /// compile time.
+    ///
+    /// @tparam Q The quality of the coherent-noise.
+    ///
+    /// This function is identical to the batch GradientCoherentNoise3D()
+    /// overloads called with @a Q as the noise quality, except that the
+    /// noise quality is not examined at run time. It is defined for double and
+    /// float input values and for all three NoiseQuality values.
+    ///
+    /// @see GradientCoherentNoise3D(const double*, const double*, const double*, double*, int, int32, NoiseQuality)
+    template <NoiseQuality Q>
+    void GradientCoherentNoise3D(const double* x, const double* y, const double* z,
+        double* out, int count, int32 seed = 0) noexcept;
+
+    /// Single-precision counterpart of the batch GradientCoherentNoise3D<Q>().
+    ///
+    /// @see GradientCoherentNoise3D(const float*, const float*, const float*, float*, int, int32, NoiseQuality)
+    template <NoiseQuality Q>
+    void GradientCoherentNoise3D(const float* x, const float* y, const float* z,
+        float* out, int count, int32 seed = 0) noexcept;
+
+    /// Generates a gradient-coherent-noise value on the plane y = 0.
+    ///
+    /// @param x The @a x coordinate of the input value.
+    /// @param z The @a z coordinate of the input value.
+    /// @param seed The random number seed.
+    /// @param noiseQuality The quality of the coherent-noise.
+    ///
+    /// @returns The generated gradient-coherent-noise value, ranging from -1.0 to +1.0.
+    ///
+    /// This function returns the value that GradientCoherentNoise3D() returns
+    /// for the input value (@a x, 0.0, @a z), with one exception: where that
+    /// value is zero, the sign of the zero may differ. Because the input value
+    /// lies on the lower face of its unit cube, this function evaluates the
+    /// four vertices of that face instead of all eight vertices of the cube,
+    /// which roughly halves the cost. Use it for planar mappings (e.g.,
+    /// noise::model::Plane), where the @a y coordinate is always zero.
+    [[nodiscard]] double GradientCoherentNoise2D(double x, double z, int32 seed = 0,
+        NoiseQuality noiseQuality = NoiseQuality::QUALITY_STD) noexcept;
+
+    /// Generates a gradient-coherent-noise value on the plane y = 0, using a
+    /// noise quality that is fixed at compile time.
+    ///
+    /// @tparam Q The quality of the coherent-noise.
+    ///
+    /// @see GradientCoherentNoise2D(double, double, int32, NoiseQuality)
+    template <NoiseQuality Q>
+    [[nodiscard]] double GradientCoherentNoise2D(double x, double z, int32 seed = 0) noexcept;
+
+    /// Generates gradient-coherent-noise values on the plane y = 0 for a batch
+    /// of input values, using a noise quality that is fixed at compile time.
+    ///
+    /// @tparam Q The quality of the coherent-noise.
+    ///
+    /// @param x Array containing the @a x coordinates of the input values.
+    /// @param z Array containing the @a z coordinates of the input values.
+    /// @param[out] out Array that receives the generated values.
+    /// @param count The number of input values.
+    /// @param seed The random number seed.
+    ///
+    /// @pre Each array holds at least @a count elements.
+    /// @pre Each coordinate can be cast to a noise::int32 value (see MakeInt32Range()).
+    ///
+    /// This is the two-dimensional counterpart of the batch
+    /// GradientCoherentNoise3D<Q>() functions; it uses the same SIMD
+    /// instruction sets. Each double-precision output value is identical to
+    /// the value that the single-point GradientCoherentNoise2D() returns for
+    /// the same input value. It is defined for double and float input values
+    /// and for all three NoiseQuality values.
+    template <NoiseQuality Q>
+    void GradientCoherentNoise2D(const double* x, const double* z,
+        double* out, int count, int32 seed = 0) noexcept;
+
+    /// Single-precision counterpart of the batch GradientCoherentNoise2D<Q>().
+    template <NoiseQuality Q>
+    void GradientCoherentNoise2D(const float* x, const float* z,
+        float* out, int count, int32 seed = 0) noexcept;
+
     /// Generates a gradient-noise value from the coordinates of a
     /// three-dimensional input value and the integer coordinates of a
     /// nearby three-dimensional value.
@@ -113,6 +320,36 @@ namespace noise {
         return n;
     }
 
+    /// Modifies a batch of floating-point values so that they can be stored in
+    /// noise::int32 variables.
+    ///
+    /// @param n Array containing the floating-point numbers.
+    /// @param[out] out Array that receives the modified numbers if any number
+    /// needs modifying.
+    /// @param count The number of values.
+    ///
+    /// @returns @a n if every number is already in range, otherwise @a out.
+    ///
+    /// @pre Each array holds at least @a count elements.
+    ///
+    /// The returned array holds the value that MakeInt32Range() returns for
+    /// each number. In the usual case, in which every number is in range, the
+    /// numbers are only compared, not copied.
+    template <typename Real>
+    [[nodiscard]] inline const Real* MakeInt32Range(const Real* n, Real* out, int count) noexcept {
+        int i = 0;
+        while (i < count && std::abs(n[i]) < Real(1073741824.0)) {
+            ++i;
+        }
+        if (i == count) {
+            return n;
+        }
+        for (i = 0; i < count; ++i) {
+            out[i] = static_cast<Real>(MakeInt32Range(static_cast<double>(n[i])));
+        }
+        return out;
+    }
+
     /// Generates a value-coherent-noise value from the coordinates of a three-dimensional input value.
     ///
     /// @param x The @a x coordinate of the input value.
@@ -127,6 +364,18 @@ namespace noise {
     [[nodiscard]] double ValueCoherentNoise3D(double x, double y, double z, int32 seed = 0,
         NoiseQuality noiseQuality = NoiseQuality::QUALITY_STD) noexcept;
 
+    /// Generates a value-coherent-noise value from the coordinates of a
+    /// three-dimensional input value, using a noise quality that is fixed at
+    /// compile time.
+    ///
+    /// @tparam Q The quality of the coherent-noise.
+    ///
+    /// This function returns the same value as ValueCoherentNoise3D() called
+    /// with @a Q as the noise quality, without branching on the noise quality.
+    /// It is defined for all three NoiseQuality values.
+    template <NoiseQuality Q>
+    [[nodiscard]] double ValueCoherentNoise3D(double x, double y, double z, int32 seed = 0) noexcept;
+
     /// Generates a value-noise value from the coordinates of a three-dimensional input value.
     ///
     /// @param x The @a x coordinate of the input value.
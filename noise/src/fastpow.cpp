@@ -0,0 +1,154 @@
+// fastpow.cpp
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+
+#include <noise/fastpow.h>
+#include "simd.h"
+
+namespace noise {
+
+    namespace {
+
+        // Signature shared by the scalar and SIMD batch FastPow() kernels. The
+        // exponent of value i is exponent[i * exponentStride].
+        using FastPowKernel = void (*)(const double* base, const double* exponent, int exponentStride,
+            double* out, int count);
+
+        // Reference kernel; evaluates each value with the single-value function.
+        void FastPowScalar(const double* base, const double* exponent, int exponentStride,
+            double* out, int count) noexcept {
+            for (int i = 0; i < count; ++i) {
+                out[i] = FastPow(base[i], exponent[i * exponentStride]);
+            }
+        }
+
+#ifdef NOISE_SIMD_X86
+
+        // The SIMD kernel performs exactly the same floating-point operations,
+        // in the same order, as detail::Log2Approx() and detail::Exp2Approx();
+        // it must not be compiled with FMA contraction so that its results stay
+        // bit-identical to the scalar reference. Groups that contain a special
+        // case (see FastPow()) are handed to the scalar reference.
+
+        NOISE_TARGET_AVX2 inline __m256d Log2Avx2(__m256d x) noexcept {
+            const __m256d twoTo52 = _mm256_set1_pd(4503599627370496.0);
+            const __m256i bits = _mm256_castpd_si256(x);
+
+            // The biased exponent occupies the low mantissa bits of 2^52.
+            const __m256d biased = _mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(bits, 52),
+                _mm256_castpd_si256(twoTo52)));
+            __m256d exponent = _mm256_sub_pd(biased, _mm256_set1_pd(4503599627370496.0 + 1023.0));
+            __m256d mantissa = _mm256_castsi256_pd(_mm256_or_si256(
+                _mm256_and_si256(bits, _mm256_set1_epi64x(0x000fffffffffffffLL)),
+                _mm256_set1_epi64x(0x3ff0000000000000LL)));
+            const __m256d isLarge = _mm256_cmp_pd(mantissa, _mm256_set1_pd(SQRT_2), _CMP_GT_OQ);
+            mantissa = _mm256_blendv_pd(mantissa, _mm256_mul_pd(mantissa, _mm256_set1_pd(0.5)), isLarge);
+            exponent = _mm256_add_pd(exponent, _mm256_and_pd(isLarge, _mm256_set1_pd(1.0)));
+
+            const __m256d one = _mm256_set1_pd(1.0);
+            const __m256d t = _mm256_div_pd(_mm256_sub_pd(mantissa, one), _mm256_add_pd(mantissa, one));
+            const __m256d t2 = _mm256_mul_pd(t, t);
+            const __m256d t4 = _mm256_mul_pd(t2, t2);
+            const __m256d t8 = _mm256_mul_pd(t4, t4);
+            const __m256d c01 = _mm256_add_pd(_mm256_set1_pd(2.8853900817779268), _mm256_mul_pd(t2, _mm256_set1_pd(0.9617966939259757)));
+            const __m256d c23 = _mm256_add_pd(_mm256_set1_pd(0.5770780163555853), _mm256_mul_pd(t2, _mm256_set1_pd(0.41219858311113244)));
+            const __m256d c45 = _mm256_add_pd(_mm256_set1_pd(0.3205988979753252), _mm256_mul_pd(t2, _mm256_set1_pd(0.2623081892525388)));
+            const __m256d c67 = _mm256_add_pd(_mm256_set1_pd(0.2219530832136867), _mm256_mul_pd(t2, _mm256_set1_pd(0.19235933878519512)));
+            const __m256d c89 = _mm256_add_pd(_mm256_set1_pd(0.16972882833987804), _mm256_mul_pd(t2, _mm256_set1_pd(0.15186263588304877)));
+            const __m256d series = _mm256_add_pd(_mm256_add_pd(c01, _mm256_mul_pd(t4, c23)),
+                _mm256_mul_pd(t8, _mm256_add_pd(_mm256_add_pd(c45, _mm256_mul_pd(t4, c67)), _mm256_mul_pd(t8, c89))));
+            return _mm256_add_pd(exponent, _mm256_mul_pd(t, series));
+        }
+
+        // Returns 2 raised to integer powers between -1022 and 1023.
+        NOISE_TARGET_AVX2 inline __m256d Exp2IntAvx2(__m256d n) noexcept {
+            // The biased exponent occupies the low mantissa bits of 2^52.
+            const __m256d biased = _mm256_add_pd(n, _mm256_set1_pd(4503599627370496.0 + 1023.0));
+            return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(biased), 52));
+        }
+
+        NOISE_TARGET_AVX2 inline __m256d Exp2Avx2(__m256d x) noexcept {
+            x = _mm256_max_pd(_mm256_min_pd(x, _mm256_set1_pd(1100.0)), _mm256_set1_pd(-1100.0));
+            const __m256d magic = _mm256_set1_pd(6755399441055744.0);
+            const __m256d rounded = _mm256_sub_pd(_mm256_add_pd(x, magic), magic);
+            const __m256d f = _mm256_sub_pd(x, rounded);
+            const __m256d f2 = _mm256_mul_pd(f, f);
+            const __m256d f4 = _mm256_mul_pd(f2, f2);
+            const __m256d f8 = _mm256_mul_pd(f4, f4);
+            const __m256d c01 = _mm256_add_pd(_mm256_set1_pd(1.0), _mm256_mul_pd(f, _mm256_set1_pd(0.6931471805599453)));
+            const __m256d c23 = _mm256_add_pd(_mm256_set1_pd(0.2402265069591007), _mm256_mul_pd(f, _mm256_set1_pd(0.055504108664821576)));
+            const __m256d c45 = _mm256_add_pd(_mm256_set1_pd(0.009618129107628477), _mm256_mul_pd(f, _mm256_set1_pd(0.0013333558146428441)));
+            const __m256d c67 = _mm256_add_pd(_mm256_set1_pd(0.00015403530393381606), _mm256_mul_pd(f, _mm256_set1_pd(1.5252733804059838e-05)));
+            const __m256d c89 = _mm256_add_pd(_mm256_set1_pd(1.3215486790144305e-06), _mm256_mul_pd(f, _mm256_set1_pd(1.0178086009239696e-07)));
+            const __m256d c1011 = _mm256_add_pd(_mm256_set1_pd(7.054911620801121e-09), _mm256_mul_pd(f, _mm256_set1_pd(4.44553827187081e-10)));
+            const __m256d c1213 = _mm256_add_pd(_mm256_set1_pd(2.5678435993488196e-11), _mm256_mul_pd(f, _mm256_set1_pd(1.3691488853904124e-12)));
+            const __m256d series = _mm256_add_pd(
+                _mm256_add_pd(_mm256_add_pd(c01, _mm256_mul_pd(f2, c23)), _mm256_mul_pd(f4, _mm256_add_pd(c45, _mm256_mul_pd(f2, c67)))),
+                _mm256_mul_pd(f8, _mm256_add_pd(_mm256_add_pd(c89, _mm256_mul_pd(f2, c1011)), _mm256_mul_pd(f4, c1213))));
+
+            // n / 2 rounds toward zero, as integer division does.
+            const __m256d n0 = _mm256_round_pd(_mm256_mul_pd(rounded, _mm256_set1_pd(0.5)), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+            const __m256d n1 = _mm256_sub_pd(rounded, n0);
+            return _mm256_mul_pd(_mm256_mul_pd(series, Exp2IntAvx2(n0)), Exp2IntAvx2(n1));
+        }
+
+        NOISE_TARGET_AVX2 void FastPowAvx2(const double* base, const double* exponent, int exponentStride,
+            double* out, int count) noexcept {
+            const __m256d minNormal = _mm256_set1_pd(DBL_MIN);
+            const __m256d maxNormal = _mm256_set1_pd(DBL_MAX);
+            const __m256d magnitudeMask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+            int i = 0;
+            for (; i + 4 <= count; i += 4) {
+                const __m256d x = _mm256_loadu_pd(base + i);
+                const __m256d y = exponentStride != 0 ? _mm256_loadu_pd(exponent + i) : _mm256_set1_pd(*exponent);
+
+                // FastPow() evaluates the approximation directly only for a
+                // positive, normal base and a finite, nonzero exponent.
+                const __m256d isPositiveNormal = _mm256_and_pd(_mm256_cmp_pd(x, minNormal, _CMP_GE_OQ),
+                    _mm256_cmp_pd(x, maxNormal, _CMP_LE_OQ));
+                const __m256d isFiniteNonzero = _mm256_and_pd(
+                    _mm256_cmp_pd(_mm256_and_pd(y, magnitudeMask), maxNormal, _CMP_LE_OQ),
+                    _mm256_cmp_pd(y, _mm256_setzero_pd(), _CMP_NEQ_OQ));
+                if (_mm256_movemask_pd(_mm256_and_pd(isPositiveNormal, isFiniteNonzero)) != 0xf) {
+                    FastPowScalar(base + i, exponent + i * exponentStride, exponentStride, out + i, 4);
+                    continue;
+                }
+
+                _mm256_storeu_pd(out + i, Exp2Avx2(_mm256_mul_pd(y, Log2Avx2(x))));
+            }
+            FastPowScalar(base + i, exponent + i * exponentStride, exponentStride, out + i, count - i);
+        }
+
+#endif // NOISE_SIMD_X86
+
+        // Selects the fastest FastPow() kernel that the processor supports.
+        FastPowKernel SelectFastPowKernel() noexcept {
+#ifdef NOISE_SIMD_X86
+            if (simd::CpuSupportsAvx2()) {
+                return FastPowAvx2;
+            }
+#endif
+            return FastPowScalar;
+        }
+
+    }
+
+    void FastPow(const double* base, const double* exponent, double* out, int count) noexcept {
+        static const FastPowKernel kernel = SelectFastPowKernel();
+        kernel(base, exponent, 1, out, count);
+    }
+
+    void FastPow(const double* base, double exponent, double* out, int count) noexcept {
+        static const FastPowKernel kernel = SelectFastPowKernel();
+        kernel(base, &exponent, 0, out, count);
+    }
+
+} // namespace noise
@@ -0,0 +1,205 @@
+// cache.cpp
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+
+#include "noise/module/cache.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+
+using namespace noise::module;
+
+namespace {
+
+    // Number of cache slots per thread for each kind of cache. Must be a power of
+    // two.
+    constexpr std::uint64_t POINT_SLOT_COUNT = 256;
+    constexpr std::uint64_t BATCH_SLOT_COUNT = 64;
+
+    // Minimum number of entries in the hash table of a batch-cache slot, and the
+    // number of entries per input value of a batch. Must be powers of two.
+    constexpr size_t MIN_TABLE_SIZE = 1024;
+    constexpr size_t TABLE_SIZE_PER_VALUE = 8;
+
+    // Maximum number of entries in the hash table of a batch-cache slot (about
+    // 640 KB in double precision). Must be a power of two. A larger batch is
+    // processed in parts of MAX_TABLE_SIZE / TABLE_SIZE_PER_VALUE input values,
+    // so the tables of a thread stay bounded whatever the batch size.
+    constexpr size_t MAX_TABLE_SIZE = 16384;
+    constexpr int MAX_PART_SIZE = static_cast<int>(MAX_TABLE_SIZE / TABLE_SIZE_PER_VALUE);
+
+    // Returns the bit pattern of a coordinate, so that the hash table matches
+    // coordinates exactly.
+    template <typename Real>
+    inline std::uint64_t GetBits(Real value) noexcept {
+        if constexpr (sizeof(Real) == sizeof(std::uint64_t)) {
+            std::uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        } else {
+            std::uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+    }
+
+    // Returns the index of the entry that holds the given coordinates, or of the
+    // unused entry where they belong.
+    template <typename Real, typename BatchCache>
+    size_t FindEntry(const BatchCache& cache, Real x, Real y, Real z) noexcept {
+        const std::uint64_t xBits = GetBits(x);
+        const std::uint64_t yBits = GetBits(y);
+        const std::uint64_t zBits = GetBits(z);
+        std::uint64_t hash = xBits * 0x9E3779B97F4A7C15ULL
+            ^ yBits * 0xC2B2AE3D27D4EB4FULL
+            ^ zBits * 0x165667B19E3779F9ULL;
+        // Coordinates on a regular grid often differ only in their high bits, so
+        // the high bits are mixed into the low bits that index the table.
+        hash ^= hash >> 33;
+        hash *= 0xFF51AFD7ED558CCDULL;
+        hash ^= hash >> 33;
+
+        const size_t mask = cache.entries.size() - 1;
+        size_t index = static_cast<size_t>(hash) & mask;
+        for (;;) {
+            const auto& entry = cache.entries[index];
+            if (entry.generation != cache.generation
+                || (GetBits(entry.x) == xBits && GetBits(entry.y) == yBits && GetBits(entry.z) == zBits)) {
+                return index;
+            }
+            index = (index + 1) & mask;
+        }
+    }
+
+}
+
+std::uint64_t Cache::NewCacheId() noexcept {
+    // Identifiers are never reused, so a slot written by a destroyed or
+    // invalidated cache module can never be mistaken for a live one.
+    static std::atomic<std::uint64_t> nextCacheId{ 1 };
+    return nextCacheId.fetch_add(1, std::memory_order_relaxed);
+}
+
+Cache::PointCache& Cache::GetPointCache(std::uint64_t cacheId) noexcept {
+    thread_local std::array<PointCache, POINT_SLOT_COUNT> slots;
+    return slots[cacheId & (POINT_SLOT_COUNT - 1)];
+}
+
+template <typename Real>
+Cache::BatchCache<Real>& Cache::GetBatchCache(std::uint64_t cacheId) noexcept {
+    thread_local std::array<BatchCache<Real>, BATCH_SLOT_COUNT> slots;
+    return slots[cacheId & (BATCH_SLOT_COUNT - 1)];
+}
+
+template <typename Real>
+void Cache::ClearBatchCache(BatchCache<Real>& cache, const EvalContext& context, int count) const noexcept {
+    const size_t minSize = std::max(MIN_TABLE_SIZE, static_cast<size_t>(count) * TABLE_SIZE_PER_VALUE);
+    if (cache.entries.size() < minSize) {
+        size_t size = MIN_TABLE_SIZE;
+        while (size < minSize) {
+            size *= 2;
+        }
+        cache.entries.assign(size, typename BatchCache<Real>::Entry());
+        cache.generation = 1;
+    } else if (++cache.generation == 0) {
+        for (auto& entry : cache.entries) {
+            entry.generation = 0;
+        }
+        cache.generation = 1;
+    }
+    cache.cacheId = m_cacheId;
+    cache.context = context;
+    cache.size = 0;
+}
+
+template <typename Real>
+void Cache::GetValuesImpl(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+    Real* out, int count) const noexcept {
+    assert(m_sourceModules[0] != nullptr && "Source module must be set before calling GetValues");
+
+    if (count > MAX_PART_SIZE) {
+        for (int start = 0; start < count; start += MAX_PART_SIZE) {
+            GetValuesImpl(context, x + start, y + start, z + start, out + start,
+                std::min(MAX_PART_SIZE, count - start));
+        }
+        return;
+    }
+
+    // Keeps the load factor of the hash table at or below 3/4 once the input
+    // values of this batch are added.
+    const auto isFull = [count](const BatchCache<Real>& cache) {
+        return (cache.size + static_cast<size_t>(count)) * 4 > cache.entries.size() * 3;
+    };
+
+    const std::uint64_t cacheId = m_cacheId;
+    BatchCache<Real>& cache = GetBatchCache<Real>(cacheId);
+    if (cache.cacheId != cacheId || !(cache.context == context) || isFull(cache)) {
+        ClearBatchCache(cache, context, count);
+    }
+
+    std::vector<int> missing;
+    for (int i = 0; i < count; ++i) {
+        const auto& entry = cache.entries[FindEntry(cache, x[i], y[i], z[i])];
+        if (entry.generation == cache.generation) {
+            out[i] = entry.value;
+        } else {
+            missing.push_back(i);
+        }
+    }
+    if (context.stats != nullptr) {
+        context.stats->cacheHits += static_cast<size_t>(count) - missing.size();
+        context.stats->cacheMisses += missing.size();
+    }
+    if (missing.empty()) {
+        return;
+    }
+
+    // As in GetValue(), the source module may contain other cache modules that
+    // share this slot, so the slot is checked again before it is written.
+    GetValuesAt(*m_sourceModules[0], context, missing.data(), static_cast<int>(missing.size()),
+        x, y, z, out, count);
+    if (cache.cacheId != cacheId || !(cache.context == context) || isFull(cache)) {
+        ClearBatchCache(cache, context, count);
+    }
+    for (const int i : missing) {
+        auto& entry = cache.entries[FindEntry(cache, x[i], y[i], z[i])];
+        if (entry.generation != cache.generation) {
+            entry.x = x[i];
+            entry.y = y[i];
+            entry.z = z[i];
+            entry.value = out[i];
+            entry.generation = cache.generation;
+            ++cache.size;
+        }
+    }
+}
+
+void Cache::GetValues(const double* x, const double* y, const double* z,
+    double* out, int count) const noexcept {
+    GetValuesImpl(EvalContext(), x, y, z, out, count);
+}
+
+void Cache::GetValues(const float* x, const float* y, const float* z,
+    float* out, int count) const noexcept {
+    GetValuesImpl(EvalContext(), x, y, z, out, count);
+}
+
+void Cache::GetValues(const EvalContext& context, const double* x, const double* y, const double* z,
+    double* out, int count) const noexcept {
+    GetValuesImpl(context, x, y, z, out, count);
+}
+
+void Cache::GetValues(const EvalContext& context, const float* x, const float* y, const float* z,
+    float* out, int count) const noexcept {
+    GetValuesImpl(context, x, y, z, out, count);
+}
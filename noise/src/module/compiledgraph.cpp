@@ -0,0 +1,1009 @@
+// compiledgraph.cpp
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+
+#include "noise/module/compiledgraph.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <set>
+#include <tuple>
+#include <typeinfo>
+#include "noise/interp.h"
+#include "noise/module/module.h"
+
+using namespace noise::module;
+
+namespace {
+
+    // Number of input values that each register slot holds.
+    constexpr int BLOCK_SIZE = 128;
+
+    // Scratch storage for the registers of one evaluation. Buffers are returned
+    // to a per-thread pool, so repeated evaluations (and compiled graphs that
+    // call other compiled graphs) do not allocate.
+    template <typename T>
+    class ScratchBuffer {
+    public:
+        explicit ScratchBuffer(size_t size) {
+            std::vector<std::vector<T>>& pool = GetPool();
+            if (!pool.empty()) {
+                m_buffer = std::move(pool.back());
+                pool.pop_back();
+            }
+            if (m_buffer.size() < size) {
+                m_buffer.resize(size);
+            }
+        }
+
+        ~ScratchBuffer() {
+            GetPool().push_back(std::move(m_buffer));
+        }
+
+        ScratchBuffer(const ScratchBuffer&) = delete;
+        ScratchBuffer& operator=(const ScratchBuffer&) = delete;
+
+        T* data() noexcept {
+            return m_buffer.data();
+        }
+
+    private:
+        static std::vector<std::vector<T>>& GetPool() {
+            thread_local std::vector<std::vector<T>> pool;
+            return pool;
+        }
+
+        std::vector<T> m_buffer;
+    };
+
+    // Returns the bit patterns of instruction parameters, so that parameters that
+    // compare equal but produce different output values (0.0 and -0.0) are kept
+    // apart.
+    std::array<std::uint64_t, 12> ParamBits(const std::array<double, 12>& params) noexcept {
+        std::array<std::uint64_t, 12> bits;
+        std::memcpy(bits.data(), params.data(), sizeof(bits));
+        return bits;
+    }
+
+    // Returns true if a value has exactly the given bit pattern.
+    bool HasBits(double value, double pattern) noexcept {
+        return std::memcmp(&value, &pattern, sizeof(double)) == 0;
+    }
+
+    // Returns true if the dynamic type of a module is exactly T. Subclasses of the
+    // built-in modules may override GetValue(), so they are not flattened.
+    template <typename T>
+    bool IsModule(const Module& module) noexcept {
+        return typeid(module) == typeid(T);
+    }
+
+    // Returns the module that a chain of Cache modules refers to.
+    const Module& SkipCaches(const Module& module) {
+        const Module* current = &module;
+        std::set<const Module*> visited;
+        while (IsModule<Cache>(*current) && visited.insert(current).second) {
+            current = &current->GetSourceModule(0);
+        }
+        return *current;
+    }
+
+    // Counts the references from distinct modules of a graph to each of its
+    // modules, looking through Cache modules. The visited map holds false for
+    // the modules whose source modules are being visited, so reaching one of
+    // them again means that the graph contains a cycle. Checking for cycles up
+    // front lets the compiler query the output ranges of any module.
+    void CountParents(const Module& module, std::map<const Module*, int>& parentCounts,
+        std::map<const Module*, bool>& visited) {
+        const auto inserted = visited.emplace(&module, false);
+        if (!inserted.second) {
+            if (!inserted.first->second) {
+                throw noise::ExceptionInvalidParam();
+            }
+            return;
+        }
+        for (int i = 0; i < module.GetSourceModuleCount(); ++i) {
+            const Module& source = module.GetSourceModule(i);
+            if (!IsModule<Cache>(module)) {
+                ++parentCounts[&SkipCaches(source)];
+            }
+            CountParents(source, parentCounts, visited);
+        }
+        inserted.first->second = true;
+    }
+
+}
+
+// Bookkeeping while a graph is compiled. Each module is emitted once for each
+// coordinate register it is evaluated at.
+struct CompiledGraph::CompileState {
+    /// Identifies the result of an instruction: its operation, operand registers
+    /// and parameters, plus the module for the operations that call one.
+    using InstructionKey = std::tuple<OpCode, int, std::array<int, 3>,
+        std::array<std::uint64_t, 12>, const Module*, std::array<const Module*, 2>>;
+
+    std::map<std::pair<const Module*, int>, int> values;
+    std::map<InstructionKey, int> instructions;
+    std::map<const Module*, int> parentCounts;
+    std::set<std::pair<const Module*, int>> inProgress;
+
+    /// The sub-program compiled for each source module of a Select or Blend
+    /// module that is evaluated only at the input values that need it.
+    std::map<const Module*, const CompiledGraph*> subgraphs;
+
+    /// Returns true if no module below a source module (looking through Cache
+    /// modules) is also used by a module outside of it.
+    bool IsPrivate(const Module& source) const {
+        std::map<const Module*, int> sourceParentCounts;
+        std::map<const Module*, bool> visited;
+        CountParents(source, sourceParentCounts, visited);
+        for (const auto& [module, count] : sourceParentCounts) {
+            if (parentCounts.at(module) != count) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// The index in the program of the instruction that writes each virtual
+    /// value register and coordinate register (-1 for the input coordinates).
+    std::vector<int> valueProducers;
+    std::vector<int> coordProducers{ -1 };
+
+    /// Returns the key of an instruction, ignoring its result register.
+    static InstructionKey GetKey(const Instruction& instruction) noexcept {
+        const bool callsModule = instruction.opCode == OpCode::Evaluate
+            || instruction.opCode == OpCode::Curve || instruction.opCode == OpCode::Terrace
+            || instruction.opCode == OpCode::Select || instruction.opCode == OpCode::Turbulence;
+        return InstructionKey(instruction.opCode, instruction.coords, instruction.sources,
+            ParamBits(instruction.params), callsModule ? instruction.module : nullptr,
+            instruction.sparseSources);
+    }
+};
+
+void CompiledGraph::Compile(const Module& root) {
+    m_program.clear();
+    m_subgraphs.clear();
+    m_coordRegisterCount = 1;
+    m_valueRegisterCount = 0;
+    m_resultRegister = -1;
+    m_valueRange = ValueRange::Unbounded();
+
+    CompileState state;
+    try {
+        std::map<const Module*, bool> visited;
+        CountParents(root, state.parentCounts, visited);
+        m_resultRegister = EmitValue(root, 0, state);
+        m_valueRange = root.GetValueRange();
+    } catch (...) {
+        m_program.clear();
+        m_subgraphs.clear();
+        m_resultRegister = -1;
+        m_valueRange = ValueRange::Unbounded();
+        throw;
+    }
+    RemoveDeadInstructions();
+    AllocateRegisters();
+    InvalidateValueRanges();
+}
+
+int CompiledGraph::EmitOp(Instruction instruction, CompileState& state) {
+    auto producer = [&](int valueRegister) -> const Instruction& {
+        return m_program[state.valueProducers[valueRegister]];
+    };
+    auto isConst = [&](int valueRegister) {
+        return valueRegister >= 0 && producer(valueRegister).opCode == OpCode::Const;
+    };
+
+    // Rewrite Invert, and Add and Multiply with a constant operand, as scale/bias
+    // operations. Adding -0.0 leaves every value unchanged (unlike adding 0.0,
+    // which turns -0.0 into 0.0), and so does multiplying by 1.0.
+    if (instruction.opCode == OpCode::Invert) {
+        instruction.opCode = OpCode::ScaleBias;
+        instruction.params[0] = -1.0;
+        instruction.params[1] = -0.0;
+    } else if ((instruction.opCode == OpCode::Add || instruction.opCode == OpCode::Multiply)
+        && isConst(instruction.sources[0]) != isConst(instruction.sources[1])) {
+        const int constIndex = isConst(instruction.sources[0]) ? 0 : 1;
+        const double constValue = producer(instruction.sources[constIndex]).params[0];
+        const bool isAdd = instruction.opCode == OpCode::Add;
+        instruction.opCode = OpCode::ScaleBias;
+        instruction.params[0] = isAdd ? 1.0 : constValue;
+        instruction.params[1] = isAdd ? constValue : -0.0;
+        instruction.sources = { instruction.sources[1 - constIndex], -1, -1 };
+    }
+
+    // Evaluate an operation whose operands are all constant at compile time,
+    // using the same code that evaluates it at run time.
+    if (instruction.opCode != OpCode::Const && instruction.opCode != OpCode::Evaluate
+        && instruction.opCode != OpCode::Select && instruction.sparseSources[0] == nullptr
+        && instruction.sparseSources[1] == nullptr) {
+        bool isFoldable = true;
+        double operands[3] = { 0.0, 0.0, 0.0 };
+        for (int i = 0; i < 3; ++i) {
+            if (instruction.sources[i] >= 0) {
+                isFoldable = isFoldable && isConst(instruction.sources[i]);
+                operands[i] = isFoldable ? producer(instruction.sources[i]).params[0] : 0.0;
+            }
+        }
+        if (isFoldable) {
+            double folded;
+            RunValueOp(instruction, &operands[0], &operands[1], &operands[2], &folded, 1);
+            instruction.opCode = OpCode::Const;
+            instruction.sources = { -1, -1, -1 };
+            instruction.params = {};
+            instruction.params[0] = folded;
+        }
+    }
+
+    if (instruction.opCode == OpCode::ScaleBias) {
+        // Merge a chain of scale/bias operations: (v * s0 + b0) * s1 + b1 equals
+        // v * (s0 * s1) + (b0 * s1 + b1) up to rounding.
+        const Instruction* inner = &producer(instruction.sources[0]);
+        if (m_isAffineCollapseEnabled && inner->opCode == OpCode::ScaleBias) {
+            const double scale = inner->params[0] * instruction.params[0];
+            const double bias = inner->params[1] * instruction.params[0] + instruction.params[1];
+            instruction.sources[0] = inner->sources[0];
+            instruction.params[0] = scale;
+            instruction.params[1] = bias;
+        }
+        if (HasBits(instruction.params[0], 1.0) && HasBits(instruction.params[1], -0.0)) {
+            return instruction.sources[0];
+        }
+    }
+
+    // An instruction that repeats an earlier one (e.g., two modules of the same
+    // type with the same parameters and source modules) reuses its result.
+    const CompileState::InstructionKey key = CompileState::GetKey(instruction);
+    const auto found = state.instructions.find(key);
+    if (found != state.instructions.end()) {
+        return found->second;
+    }
+    instruction.result = m_valueRegisterCount++;
+    state.valueProducers.push_back(static_cast<int>(m_program.size()));
+    m_program.push_back(instruction);
+    state.instructions.emplace(key, instruction.result);
+    return instruction.result;
+}
+
+int CompiledGraph::EmitCoords(Instruction instruction, CompileState& state) {
+    const std::array<double, 12>& p = instruction.params;
+    if (instruction.opCode == OpCode::ScalePoint
+        && HasBits(p[0], 1.0) && HasBits(p[1], 1.0) && HasBits(p[2], 1.0)) {
+        return instruction.coords;
+    }
+    if (instruction.opCode == OpCode::TranslatePoint
+        && HasBits(p[0], -0.0) && HasBits(p[1], -0.0) && HasBits(p[2], -0.0)) {
+        return instruction.coords;
+    }
+
+    // Compose a chain of point transforms into one 3x4 affine transform.
+    auto isAffine = [](OpCode opCode) {
+        return opCode != OpCode::Displace && opCode != OpCode::Turbulence;
+    };
+    const int innerIndex = state.coordProducers[instruction.coords];
+    if (m_isAffineCollapseEnabled && innerIndex >= 0
+        && isAffine(instruction.opCode) && isAffine(m_program[innerIndex].opCode)) {
+        auto toAffine = [](const Instruction& transform) {
+            const std::array<double, 12>& q = transform.params;
+            switch (transform.opCode) {
+                case OpCode::ScalePoint:
+                    return std::array<double, 12>{ q[0], 0.0, 0.0, 0.0, 0.0, q[1], 0.0, 0.0, 0.0, 0.0, q[2], 0.0 };
+                case OpCode::TranslatePoint:
+                    return std::array<double, 12>{ 1.0, 0.0, 0.0, q[0], 0.0, 1.0, 0.0, q[1], 0.0, 0.0, 1.0, q[2] };
+                case OpCode::RotatePoint:
+                    return std::array<double, 12>{ q[0], q[1], q[2], 0.0, q[3], q[4], q[5], 0.0, q[6], q[7], q[8], 0.0 };
+                default:
+                    return q;
+            }
+        };
+        const Instruction& inner = m_program[innerIndex];
+        const std::array<double, 12> a = toAffine(inner);
+        const std::array<double, 12> b = toAffine(instruction);
+        std::array<double, 12> composed;
+        for (int row = 0; row < 3; ++row) {
+            for (int column = 0; column < 4; ++column) {
+                composed[row * 4 + column] = b[row * 4] * a[column]
+                    + b[row * 4 + 1] * a[4 + column]
+                    + b[row * 4 + 2] * a[8 + column];
+            }
+            composed[row * 4 + 3] += b[row * 4 + 3];
+        }
+        instruction.opCode = OpCode::Affine;
+        instruction.coords = inner.coords;
+        instruction.params = composed;
+    }
+
+    const CompileState::InstructionKey key = CompileState::GetKey(instruction);
+    const auto found = state.instructions.find(key);
+    if (found != state.instructions.end()) {
+        return found->second;
+    }
+    instruction.result = m_coordRegisterCount++;
+    state.coordProducers.push_back(static_cast<int>(m_program.size()));
+    m_program.push_back(instruction);
+    state.instructions.emplace(key, instruction.result);
+    return instruction.result;
+}
+
+void CompiledGraph::EmitSource(const Module& source, int coords, Instruction& instruction,
+    int index, CompileState& state) {
+    // A source module that other modules also use is flattened, so that it is
+    // evaluated once for all of them, and so is a constant.
+    const Module& target = SkipCaches(source);
+    if (state.parentCounts[&target] > 1 || IsModule<Const>(target)) {
+        instruction.sources[index] = EmitValue(source, coords, state);
+        return;
+    }
+    // A sub-program would evaluate the modules that it shares with the rest of
+    // the graph a second time, so such a source module is called directly,
+    // where its Cache modules share their values with the other callers.
+    if (!state.IsPrivate(target)) {
+        instruction.sparseSources[index] = &source;
+        return;
+    }
+    auto found = state.subgraphs.find(&target);
+    if (found == state.subgraphs.end()) {
+        auto subgraph = std::make_shared<CompiledGraph>();
+        subgraph->m_isAffineCollapseEnabled = m_isAffineCollapseEnabled;
+        subgraph->Compile(target);
+        found = state.subgraphs.emplace(&target, subgraph.get()).first;
+        m_subgraphs.push_back(std::move(subgraph));
+    }
+    instruction.sparseSources[index] = found->second;
+}
+
+int CompiledGraph::EmitValue(const Module& module, int coords, CompileState& state) {
+    const auto key = std::make_pair(&module, coords);
+    const auto found = state.values.find(key);
+    if (found != state.values.end()) {
+        return found->second;
+    }
+    if (!state.inProgress.insert(key).second) {
+        throw noise::ExceptionInvalidParam();
+    }
+
+    Instruction op{};
+    op.coords = coords;
+    op.sources = { -1, -1, -1 };
+    op.module = &module;
+
+    // Emits the source modules of this module at the same coordinates.
+    auto emitSources = [&](int sourceCount) {
+        for (int i = 0; i < sourceCount; ++i) {
+            op.sources[i] = EmitValue(module.GetSourceModule(i), coords, state);
+        }
+    };
+
+    int result;
+    if (IsModule<Cache>(module)) {
+        result = EmitValue(module.GetSourceModule(0), coords, state);
+    } else if (IsModule<Const>(module)) {
+        op.opCode = OpCode::Const;
+        op.params[0] = static_cast<const Const&>(module).GetConstValue();
+        result = EmitOp(op, state);
+    } else if (module.GetSourceModuleCount() == 0) {
+        op.opCode = OpCode::Evaluate;
+        result = EmitOp(op, state);
+    } else if (IsModule<Abs>(module)) {
+        op.opCode = OpCode::Abs;
+        emitSources(1);
+        result = EmitOp(op, state);
+    } else if (IsModule<Clamp>(module)) {
+        const Clamp& clamp = static_cast<const Clamp&>(module);
+        double boundValue;
+        if (clamp.IsClampedToBound(boundValue)) {
+            // Every output value of the source module is clamped to one bound.
+            op.opCode = OpCode::Const;
+            op.params[0] = boundValue;
+        } else {
+            op.opCode = OpCode::Clamp;
+            op.params[0] = clamp.GetLowerBound();
+            op.params[1] = clamp.GetUpperBound();
+            emitSources(1);
+        }
+        result = EmitOp(op, state);
+    } else if (IsModule<Curve>(module)) {
+        op.opCode = OpCode::Curve;
+        emitSources(1);
+        result = EmitOp(op, state);
+    } else if (IsModule<Exponent>(module)) {
+        op.opCode = OpCode::Exponent;
+        op.params[0] = static_cast<const Exponent&>(module).GetExponent();
+        op.params[1] = static_cast<const Exponent&>(module).IsFastPowEnabled() ? 1.0 : 0.0;
+        emitSources(1);
+        result = EmitOp(op, state);
+    } else if (IsModule<Invert>(module)) {
+        op.opCode = OpCode::Invert;
+        emitSources(1);
+        result = EmitOp(op, state);
+    } else if (IsModule<ScaleBias>(module)) {
+        const ScaleBias& scaleBias = static_cast<const ScaleBias&>(module);
+        op.opCode = OpCode::ScaleBias;
+        op.params[0] = scaleBias.GetScale();
+        op.params[1] = scaleBias.GetBias();
+        emitSources(1);
+        result = EmitOp(op, state);
+    } else if (IsModule<Terrace>(module)) {
+        op.opCode = OpCode::Terrace;
+        emitSources(1);
+        result = EmitOp(op, state);
+    } else if (IsModule<Add>(module) || IsModule<Max>(module) || IsModule<Min>(module)
+        || IsModule<Multiply>(module) || IsModule<Power>(module)) {
+        // The output ranges of the source modules can show that one of them
+        // always wins a Max or Min module.
+        const int dominantSource = IsModule<Max>(module) ? static_cast<const Max&>(module).GetDominantSource()
+            : IsModule<Min>(module) ? static_cast<const Min&>(module).GetDominantSource()
+            : -1;
+        if (dominantSource >= 0) {
+            result = EmitValue(module.GetSourceModule(dominantSource), coords, state);
+        } else {
+            op.opCode = IsModule<Add>(module) ? OpCode::Add
+                : IsModule<Max>(module) ? OpCode::Max
+                : IsModule<Min>(module) ? OpCode::Min
+                : IsModule<Multiply>(module) ? OpCode::Multiply
+                : OpCode::Power;
+            if (op.opCode == OpCode::Power) {
+                op.params[0] = static_cast<const Power&>(module).IsFastPowEnabled() ? 1.0 : 0.0;
+            }
+            emitSources(2);
+            result = EmitOp(op, state);
+        }
+    } else if (IsModule<Blend>(module)) {
+        op.opCode = OpCode::Blend;
+        op.sources[2] = EmitValue(module.GetSourceModule(2), coords, state);
+        // A constant control value that gives one source module the full weight
+        // selects that source module outright.
+        const Instruction& control = m_program[state.valueProducers[op.sources[2]]];
+        const double alpha = (control.opCode == OpCode::Const) ? (control.params[0] + 1.0) / 2.0 : 0.5;
+        if (alpha == 0.0 || alpha == 1.0) {
+            result = EmitValue(module.GetSourceModule(alpha == 0.0 ? 0 : 1), coords, state);
+        } else {
+            // Like the Blend module, the program evaluates a source module only at
+            // the input values that give it a nonzero weight.
+            for (int i = 0; i < 2; ++i) {
+                EmitSource(module.GetSourceModule(i), coords, op, i, state);
+            }
+            result = EmitOp(op, state);
+        }
+    } else if (IsModule<Select>(module)) {
+        const Select& select = static_cast<const Select&>(module);
+        op.opCode = OpCode::Select;
+        op.params[0] = select.GetLowerBound();
+        op.params[1] = select.GetUpperBound();
+        op.params[2] = select.GetEdgeFalloff();
+        // A control module whose output range (or folded constant value) selects
+        // one source module outright is not evaluated at all.
+        int selectedSource = select.GetSelectedSource(module.GetSourceModule(2).GetValueRange());
+        if (selectedSource < 0) {
+            op.sources[2] = EmitValue(module.GetSourceModule(2), coords, state);
+            const Instruction& control = m_program[state.valueProducers[op.sources[2]]];
+            if (control.opCode == OpCode::Const) {
+                selectedSource = select.GetSelectedSource({ control.params[0], control.params[0] });
+            }
+        }
+        if (selectedSource >= 0) {
+            result = EmitValue(module.GetSourceModule(selectedSource), coords, state);
+        } else {
+            // Like the Select module, the program evaluates a selectable source
+            // module only at the input values that need it.
+            for (int i = 0; i < 2; ++i) {
+                EmitSource(module.GetSourceModule(i), coords, op, i, state);
+            }
+            result = EmitOp(op, state);
+        }
+    } else if (IsModule<ScalePoint>(module)) {
+        const ScalePoint& scalePoint = static_cast<const ScalePoint&>(module);
+        op.opCode = OpCode::ScalePoint;
+        op.params[0] = scalePoint.GetXScale();
+        op.params[1] = scalePoint.GetYScale();
+        op.params[2] = scalePoint.GetZScale();
+        result = EmitValue(module.GetSourceModule(0), EmitCoords(op, state), state);
+    } else if (IsModule<TranslatePoint>(module)) {
+        const TranslatePoint& translatePoint = static_cast<const TranslatePoint&>(module);
+        op.opCode = OpCode::TranslatePoint;
+        op.params[0] = translatePoint.GetXTranslation();
+        op.params[1] = translatePoint.GetYTranslation();
+        op.params[2] = translatePoint.GetZTranslation();
+        result = EmitValue(module.GetSourceModule(0), EmitCoords(op, state), state);
+    } else if (IsModule<RotatePoint>(module)) {
+        const RotatePoint& rotatePoint = static_cast<const RotatePoint&>(module);
+        op.opCode = OpCode::RotatePoint;
+        op.params = {
+            rotatePoint.m_x1Matrix, rotatePoint.m_y1Matrix, rotatePoint.m_z1Matrix,
+            rotatePoint.m_x2Matrix, rotatePoint.m_y2Matrix, rotatePoint.m_z2Matrix,
+            rotatePoint.m_x3Matrix, rotatePoint.m_y3Matrix, rotatePoint.m_z3Matrix
+        };
+        result = EmitValue(module.GetSourceModule(0), EmitCoords(op, state), state);
+    } else if (IsModule<Displace>(module)) {
+        op.opCode = OpCode::Displace;
+        op.params[0] = 1.0;
+        for (int i = 0; i < 3; ++i) {
+            op.sources[i] = EmitValue(module.GetSourceModule(i + 1), coords, state);
+        }
+        result = EmitValue(module.GetSourceModule(0), EmitCoords(op, state), state);
+    } else if (IsModule<Turbulence>(module)) {
+        // Turbulence displaces the input value by the output values of its three
+        // distortion modules, which it evaluates in one fused pass.
+        op.opCode = OpCode::Turbulence;
+        result = EmitValue(module.GetSourceModule(0), EmitCoords(op, state), state);
+    } else {
+        // A module type that the compiler does not know evaluates its own sources.
+        for (int i = 0; i < module.GetSourceModuleCount(); ++i) {
+            (void)module.GetSourceModule(i);
+        }
+        op.opCode = OpCode::Evaluate;
+        result = EmitOp(op, state);
+    }
+
+    state.inProgress.erase(key);
+    state.values.emplace(key, result);
+    return result;
+}
+
+void CompiledGraph::RemoveDeadInstructions() {
+    auto isCoordOp = [](OpCode opCode) {
+        return opCode == OpCode::ScalePoint || opCode == OpCode::TranslatePoint
+            || opCode == OpCode::RotatePoint || opCode == OpCode::Affine || opCode == OpCode::Displace
+            || opCode == OpCode::Turbulence;
+    };
+    std::vector<bool> isValueLive(static_cast<size_t>(m_valueRegisterCount), false);
+    std::vector<bool> isCoordLive(static_cast<size_t>(m_coordRegisterCount), false);
+    isValueLive[m_resultRegister] = true;
+
+    std::vector<Instruction> program;
+    for (auto it = m_program.rbegin(); it != m_program.rend(); ++it) {
+        const bool isLive = isCoordOp(it->opCode) ? isCoordLive[it->result] : isValueLive[it->result];
+        if (!isLive) {
+            continue;
+        }
+        for (int source : it->sources) {
+            if (source >= 0) {
+                isValueLive[source] = true;
+            }
+        }
+        isCoordLive[it->coords] = true;
+        program.push_back(*it);
+    }
+    m_program.assign(program.rbegin(), program.rend());
+}
+
+void CompiledGraph::AllocateRegisters() {
+    // Find the last instruction that reads each virtual register.
+    std::vector<int> lastValueUse(static_cast<size_t>(m_valueRegisterCount), -1);
+    std::vector<int> lastCoordUse(static_cast<size_t>(m_coordRegisterCount), -1);
+    for (int i = 0; i < static_cast<int>(m_program.size()); ++i) {
+        const Instruction& instruction = m_program[i];
+        for (int source : instruction.sources) {
+            if (source >= 0) {
+                lastValueUse[source] = i;
+            }
+        }
+        lastCoordUse[instruction.coords] = i;
+    }
+    lastValueUse[m_resultRegister] = static_cast<int>(m_program.size());
+
+    // Map the virtual registers onto as few physical registers as possible. The
+    // operations are element-wise, so an instruction may write the register of
+    // an operand that it reads for the last time. Coordinate register 0 is the
+    // input value and is never reused.
+    std::vector<int> valueMap(lastValueUse.size(), -1), coordMap(lastCoordUse.size(), -1);
+    std::vector<int> freeValues, freeCoords;
+    int valueCount = 0, coordCount = 1;
+    coordMap[0] = 0;
+    auto isCoordOp = [](OpCode opCode) {
+        return opCode == OpCode::ScalePoint || opCode == OpCode::TranslatePoint
+            || opCode == OpCode::RotatePoint || opCode == OpCode::Affine || opCode == OpCode::Displace
+            || opCode == OpCode::Turbulence;
+    };
+    for (int i = 0; i < static_cast<int>(m_program.size()); ++i) {
+        Instruction& instruction = m_program[i];
+        const std::array<int, 3> virtualSources = instruction.sources;
+        for (int& source : instruction.sources) {
+            if (source >= 0) {
+                source = valueMap[source];
+            }
+        }
+        for (int virtualRegister : virtualSources) {
+            // An instruction may read the same register more than once.
+            if (virtualRegister >= 0 && lastValueUse[virtualRegister] == i
+                && valueMap[virtualRegister] >= 0) {
+                freeValues.push_back(valueMap[virtualRegister]);
+                valueMap[virtualRegister] = -1;
+            }
+        }
+        const int virtualCoords = instruction.coords;
+        instruction.coords = coordMap[virtualCoords];
+        if (virtualCoords != 0 && lastCoordUse[virtualCoords] == i) {
+            freeCoords.push_back(coordMap[virtualCoords]);
+        }
+
+        if (isCoordOp(instruction.opCode)) {
+            int physical;
+            if (!freeCoords.empty()) {
+                physical = freeCoords.back();
+                freeCoords.pop_back();
+            } else {
+                physical = coordCount++;
+            }
+            coordMap[instruction.result] = physical;
+            instruction.result = physical;
+        } else {
+            // Evaluate calls a module that may read its coordinates after writing
+            // some output values, so its result never shares a register with them;
+            // value and coordinate registers are disjoint, which guarantees this.
+            int physical;
+            if (!freeValues.empty()) {
+                physical = freeValues.back();
+                freeValues.pop_back();
+            } else {
+                physical = valueCount++;
+            }
+            valueMap[instruction.result] = physical;
+            instruction.result = physical;
+        }
+    }
+
+    m_resultRegister = valueMap[m_resultRegister];
+    m_valueRegisterCount = valueCount;
+    m_coordRegisterCount = coordCount;
+}
+
+double CompiledGraph::GetValue(double x, double y, double z) const noexcept {
+    return GetValue(EvalContext(), x, y, z);
+}
+
+double CompiledGraph::GetValue(const EvalContext& context, double x, double y, double z) const noexcept {
+    double value;
+    GetValues(context, &x, &y, &z, &value, 1);
+    return value;
+}
+
+void CompiledGraph::GetValues(const double* x, const double* y, const double* z,
+    double* out, int count) const noexcept {
+    GetValues(EvalContext(), x, y, z, out, count);
+}
+
+void CompiledGraph::GetValues(const EvalContext& context, const double* x, const double* y,
+    const double* z, double* out, int count) const noexcept {
+    assert(m_resultRegister >= 0 && "A graph must be compiled before calling GetValues");
+
+    // Coordinate register 0 refers to the caller's arrays, so it needs no storage.
+    ScratchBuffer<double> registers(static_cast<size_t>(m_valueRegisterCount + 3 * (m_coordRegisterCount - 1))
+        * BLOCK_SIZE);
+    ScratchBuffer<EvalContext> coordContexts(static_cast<size_t>(m_coordRegisterCount));
+    coordContexts.data()[0] = context;
+    for (int start = 0; start < count; start += BLOCK_SIZE) {
+        const int blockCount = std::min(BLOCK_SIZE, count - start);
+        RunBlock(x + start, y + start, z + start, out + start, blockCount, registers.data(),
+            coordContexts.data());
+    }
+}
+
+void CompiledGraph::GetValues(const EvalContext& context, const float* x, const float* y,
+    const float* z, float* out, int count) const noexcept {
+    assert(m_resultRegister >= 0 && "A graph must be compiled before calling GetValues");
+
+    // The program runs in double precision, so each block of input values is
+    // converted first.
+    ScratchBuffer<double> registers(static_cast<size_t>(m_valueRegisterCount + 3 * (m_coordRegisterCount - 1))
+        * BLOCK_SIZE);
+    ScratchBuffer<EvalContext> coordContexts(static_cast<size_t>(m_coordRegisterCount));
+    coordContexts.data()[0] = context;
+    double blockX[BLOCK_SIZE], blockY[BLOCK_SIZE], blockZ[BLOCK_SIZE], blockOut[BLOCK_SIZE];
+    for (int start = 0; start < count; start += BLOCK_SIZE) {
+        const int blockCount = std::min(BLOCK_SIZE, count - start);
+        for (int i = 0; i < blockCount; ++i) {
+            blockX[i] = x[start + i];
+            blockY[i] = y[start + i];
+            blockZ[i] = z[start + i];
+        }
+        RunBlock(blockX, blockY, blockZ, blockOut, blockCount, registers.data(), coordContexts.data());
+        for (int i = 0; i < blockCount; ++i) {
+            out[start + i] = static_cast<float>(blockOut[i]);
+        }
+    }
+}
+
+void CompiledGraph::RunSparseSource(const Module* module, const bool* isNeeded,
+    const EvalContext& context, const double* x, const double* y, const double* z,
+    const double*& source, double* values, int count) noexcept {
+    if (module == nullptr) {
+        return;
+    }
+    int indices[BLOCK_SIZE];
+    int indexCount = 0;
+    for (int i = 0; i < count; ++i) {
+        if (isNeeded[i]) {
+            indices[indexCount++] = i;
+        }
+    }
+    GetValuesAt(*module, context, indices, indexCount, x, y, z, values, count);
+    source = values;
+}
+
+void CompiledGraph::RunSelect(const Instruction& instruction, const EvalContext& context,
+    const double* source0, const double* source1, const double* control,
+    const double* x, const double* y, const double* z, double* out, int count) noexcept {
+    const Select& select = static_cast<const Select&>(*instruction.module);
+    Select::SelectionRegion regions[BLOCK_SIZE];
+    double alphas[BLOCK_SIZE];
+    bool isNeeded[2][BLOCK_SIZE];
+    for (int i = 0; i < count; ++i) {
+        regions[i] = select.GetSelectionRegion(control[i], alphas[i]);
+        isNeeded[0][i] = regions[i] != Select::SelectionRegion::Source1;
+        isNeeded[1][i] = regions[i] != Select::SelectionRegion::Source0;
+    }
+
+    const double* sources[2] = { source0, source1 };
+    double sourceValues[2][BLOCK_SIZE];
+    for (int source = 0; source < 2; ++source) {
+        RunSparseSource(instruction.sparseSources[source], isNeeded[source], context, x, y, z,
+            sources[source], sourceValues[source], count);
+    }
+    for (int i = 0; i < count; ++i) {
+        out[i] = Select::GetRegionValue(regions[i], alphas[i], sources[0][i], sources[1][i]);
+    }
+}
+
+void CompiledGraph::RunBlend(const Instruction& instruction, const EvalContext& context,
+    const double* source0, const double* source1, const double* control,
+    const double* x, const double* y, const double* z, double* out, int count) noexcept {
+    double alphas[BLOCK_SIZE];
+    bool isNeeded[2][BLOCK_SIZE];
+    for (int i = 0; i < count; ++i) {
+        alphas[i] = (control[i] + 1.0) / 2.0;
+        isNeeded[0][i] = alphas[i] != 1.0;
+        isNeeded[1][i] = alphas[i] != 0.0;
+    }
+
+    const double* sources[2] = { source0, source1 };
+    double sourceValues[2][BLOCK_SIZE];
+    for (int source = 0; source < 2; ++source) {
+        RunSparseSource(instruction.sparseSources[source], isNeeded[source], context, x, y, z,
+            sources[source], sourceValues[source], count);
+    }
+    for (int i = 0; i < count; ++i) {
+        out[i] = SelectInterp(sources[0][i], sources[1][i], alphas[i]);
+    }
+}
+
+void CompiledGraph::RunBlock(const double* x, const double* y, const double* z,
+    double* out, int count, double* registers, EvalContext* coordContexts) const noexcept {
+    double* coordRegisters = registers + static_cast<size_t>(m_valueRegisterCount) * BLOCK_SIZE;
+    auto value = [&](int index) {
+        return registers + static_cast<size_t>(index) * BLOCK_SIZE;
+    };
+    auto coord = [&](int index, int axis) -> double* {
+        return coordRegisters + (static_cast<size_t>(index - 1) * 3 + axis) * BLOCK_SIZE;
+    };
+
+    for (const Instruction& instruction : m_program) {
+        const double* cx = x;
+        const double* cy = y;
+        const double* cz = z;
+        if (instruction.coords != 0) {
+            cx = coord(instruction.coords, 0);
+            cy = coord(instruction.coords, 1);
+            cz = coord(instruction.coords, 2);
+        }
+        const double* s0 = instruction.sources[0] >= 0 ? value(instruction.sources[0]) : nullptr;
+        const double* s1 = instruction.sources[1] >= 0 ? value(instruction.sources[1]) : nullptr;
+        const double* s2 = instruction.sources[2] >= 0 ? value(instruction.sources[2]) : nullptr;
+        const std::array<double, 12>& p = instruction.params;
+        const EvalContext& context = coordContexts[instruction.coords];
+
+        switch (instruction.opCode) {
+            case OpCode::Evaluate:
+                instruction.module->GetValues(context, cx, cy, cz, value(instruction.result), count);
+                break;
+            case OpCode::Select:
+                RunSelect(instruction, context, s0, s1, s2, cx, cy, cz, value(instruction.result), count);
+                break;
+            case OpCode::Blend:
+                RunBlend(instruction, context, s0, s1, s2, cx, cy, cz, value(instruction.result), count);
+                break;
+            case OpCode::ScalePoint: {
+                // As in the ScalePoint module, the sample spacing grows by the
+                // largest scaling factor.
+                coordContexts[instruction.result] = context.Scaled(
+                    std::max({ std::fabs(p[0]), std::fabs(p[1]), std::fabs(p[2]) }));
+                double* rx = coord(instruction.result, 0);
+                double* ry = coord(instruction.result, 1);
+                double* rz = coord(instruction.result, 2);
+                for (int i = 0; i < count; ++i) {
+                    rx[i] = cx[i] * p[0];
+                    ry[i] = cy[i] * p[1];
+                    rz[i] = cz[i] * p[2];
+                }
+                break;
+            }
+            case OpCode::TranslatePoint: {
+                coordContexts[instruction.result] = context;
+                double* rx = coord(instruction.result, 0);
+                double* ry = coord(instruction.result, 1);
+                double* rz = coord(instruction.result, 2);
+                for (int i = 0; i < count; ++i) {
+                    rx[i] = cx[i] + p[0];
+                    ry[i] = cy[i] + p[1];
+                    rz[i] = cz[i] + p[2];
+                }
+                break;
+            }
+            case OpCode::RotatePoint: {
+                coordContexts[instruction.result] = context;
+                double* rx = coord(instruction.result, 0);
+                double* ry = coord(instruction.result, 1);
+                double* rz = coord(instruction.result, 2);
+                for (int i = 0; i < count; ++i) {
+                    const double px = cx[i], py = cy[i], pz = cz[i];
+                    rx[i] = (p[0] * px) + (p[1] * py) + (p[2] * pz);
+                    ry[i] = (p[3] * px) + (p[4] * py) + (p[5] * pz);
+                    rz[i] = (p[6] * px) + (p[7] * py) + (p[8] * pz);
+                }
+                break;
+            }
+            case OpCode::Affine: {
+                // The sample spacing grows by up to the largest row norm.
+                double maxRowNorm = 0.0;
+                for (int row = 0; row < 3; ++row) {
+                    maxRowNorm = std::max(maxRowNorm, std::sqrt(p[row * 4] * p[row * 4]
+                        + p[row * 4 + 1] * p[row * 4 + 1] + p[row * 4 + 2] * p[row * 4 + 2]));
+                }
+                coordContexts[instruction.result] = context.Scaled(maxRowNorm);
+                double* rx = coord(instruction.result, 0);
+                double* ry = coord(instruction.result, 1);
+                double* rz = coord(instruction.result, 2);
+                for (int i = 0; i < count; ++i) {
+                    const double px = cx[i], py = cy[i], pz = cz[i];
+                    rx[i] = (p[0] * px) + (p[1] * py) + (p[2] * pz) + p[3];
+                    ry[i] = (p[4] * px) + (p[5] * py) + (p[6] * pz) + p[7];
+                    rz[i] = (p[8] * px) + (p[9] * py) + (p[10] * pz) + p[11];
+                }
+                break;
+            }
+            case OpCode::Turbulence:
+                coordContexts[instruction.result] = context;
+                static_cast<const Turbulence&>(*instruction.module).GetDistortedValues(context, cx, cy, cz,
+                    coord(instruction.result, 0), coord(instruction.result, 1), coord(instruction.result, 2), count);
+                break;
+            case OpCode::Displace: {
+                coordContexts[instruction.result] = context;
+                double* rx = coord(instruction.result, 0);
+                double* ry = coord(instruction.result, 1);
+                double* rz = coord(instruction.result, 2);
+                for (int i = 0; i < count; ++i) {
+                    rx[i] = cx[i] + (s0[i] * p[0]);
+                    ry[i] = cy[i] + (s1[i] * p[0]);
+                    rz[i] = cz[i] + (s2[i] * p[0]);
+                }
+                break;
+            }
+            default:
+                RunValueOp(instruction, s0, s1, s2, value(instruction.result), count);
+                break;
+        }
+    }
+
+    std::copy(value(m_resultRegister), value(m_resultRegister) + count, out);
+}
+
+void CompiledGraph::RunValueOp(const Instruction& instruction, const double* s0,
+    const double* s1, const double* s2, double* result, int count) noexcept {
+    const std::array<double, 12>& p = instruction.params;
+    switch (instruction.opCode) {
+        case OpCode::Const: {
+            std::fill(result, result + count, p[0]);
+            break;
+        }
+        case OpCode::Abs: {
+            for (int i = 0; i < count; ++i) {
+                result[i] = std::abs(s0[i]);
+            }
+            break;
+        }
+        case OpCode::Clamp: {
+            for (int i = 0; i < count; ++i) {
+                result[i] = std::clamp(s0[i], p[0], p[1]);
+            }
+            break;
+        }
+        case OpCode::Curve: {
+            const Curve& curve = static_cast<const Curve&>(*instruction.module);
+            for (int i = 0; i < count; ++i) {
+                result[i] = curve.MapSourceValue(s0[i]);
+            }
+            break;
+        }
+        case OpCode::Exponent: {
+            if (p[1] != 0.0) {
+                for (int i = 0; i < count; ++i) {
+                    result[i] = std::fabs((s0[i] + 1.0) / 2.0);
+                }
+                const FastPower power(p[0]);
+                power(result, result, count);
+                for (int i = 0; i < count; ++i) {
+                    result[i] = result[i] * 2.0 - 1.0;
+                }
+                break;
+            }
+            for (int i = 0; i < count; ++i) {
+                const double normalized = (s0[i] + 1.0) / 2.0;
+                result[i] = std::pow(std::fabs(normalized), p[0]) * 2.0 - 1.0;
+            }
+            break;
+        }
+        case OpCode::Invert: {
+            for (int i = 0; i < count; ++i) {
+                result[i] = -s0[i];
+            }
+            break;
+        }
+        case OpCode::ScaleBias: {
+            for (int i = 0; i < count; ++i) {
+                result[i] = s0[i] * p[0] + p[1];
+            }
+            break;
+        }
+        case OpCode::Terrace: {
+            const Terrace& terrace = static_cast<const Terrace&>(*instruction.module);
+            for (int i = 0; i < count; ++i) {
+                result[i] = terrace.MapSourceValue(s0[i]);
+            }
+            break;
+        }
+        case OpCode::Add: {
+            for (int i = 0; i < count; ++i) {
+                result[i] = s0[i] + s1[i];
+            }
+            break;
+        }
+        case OpCode::Max: {
+            for (int i = 0; i < count; ++i) {
+                result[i] = std::max(s0[i], s1[i]);
+            }
+            break;
+        }
+        case OpCode::Min: {
+            for (int i = 0; i < count; ++i) {
+                result[i] = std::min(s0[i], s1[i]);
+            }
+            break;
+        }
+        case OpCode::Multiply: {
+            for (int i = 0; i < count; ++i) {
+                result[i] = s0[i] * s1[i];
+            }
+            break;
+        }
+        case OpCode::Power: {
+            if (p[0] != 0.0) {
+                FastPow(s1, s0, result, count);
+                break;
+            }
+            for (int i = 0; i < count; ++i) {
+                result[i] = std::pow(s1[i], s0[i]);
+            }
+            break;
+        }
+        case OpCode::Blend: {
+            for (int i = 0; i < count; ++i) {
+                result[i] = SelectInterp(s0[i], s1[i], (s2[i] + 1.0) / 2.0);
+            }
+            break;
+        }
+        default:
+            assert(false && "Not an operation on value registers");
+            break;
+    }
+}
@@ -22,60 +22,135 @@
 // - Optimized GetValue by using references to control points.
 // - Improved documentation with consistent formatting.
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "noise/interp.h"
 #include "noise/module/curve.h"
 
 using namespace noise::module;
 
+namespace {
+
+    // Returns the index of the first control point with an input value greater
+    // than the given value, or the number of control points if there is none
+    // (as std::upper_bound() does). The search halves the range without
+    // branching on the comparisons, which mispredict for noise values.
+    int FindUpperControlPoint(const ControlPoint* controlPoints, int count, double value) noexcept {
+        if (count == 0) {
+            return 0;
+        }
+        const ControlPoint* base = controlPoints;
+        while (count > 1) {
+            const int half = count / 2;
+            base = (value < base[half].inputValue) ? base : base + half;
+            count -= half;
+        }
+        return static_cast<int>(base - controlPoints) + (value < base->inputValue ? 0 : 1);
+    }
+
+}
+
 void Curve::AddControlPoint(double inputValue, double outputValue) {
     // Find the insertion point and insert the new control point.
     int insertionPos = FindInsertionPos(inputValue);
     InsertAtPos(insertionPos, inputValue, outputValue);
+    CalcSegments();
+    InvalidateValueRanges();
+}
+
+void Curve::CalcSegments() {
+    const int controlPointCount = static_cast<int>(m_controlPoints.size());
+    m_segments.resize(std::max(controlPointCount - 1, 0));
+    for (int index1 = 0; index1 + 1 < controlPointCount; ++index1) {
+        const int index2 = index1 + 1;
+        const double n0 = m_controlPoints[std::max(index1 - 1, 0)].outputValue;
+        const double n1 = m_controlPoints[index1].outputValue;
+        const double n2 = m_controlPoints[index2].outputValue;
+        const double n3 = m_controlPoints[std::min(index2 + 1, controlPointCount - 1)].outputValue;
+
+        Segment& segment = m_segments[index1];
+        segment.inputValue = m_controlPoints[index1].inputValue;
+        segment.inputWidth = m_controlPoints[index2].inputValue - segment.inputValue;
+        segment.p = (n3 - n2) - (n0 - n1);
+        segment.q = (n0 - n1) - segment.p;
+        segment.r = n2 - n0;
+        segment.s = n1;
+    }
 }
 
 int Curve::FindInsertionPos(double inputValue) const {
-    for (int i = 0; i < static_cast<int>(m_controlPoints.size()); ++i) {
-        if (inputValue < m_controlPoints[i].inputValue) {
-            return i;
-        }
-        if (inputValue == m_controlPoints[i].inputValue) {
-            throw noise::ExceptionInvalidParam();
-        }
+    const auto pos = std::lower_bound(m_controlPoints.begin(), m_controlPoints.end(), inputValue,
+        [](const ControlPoint& point, double value) { return point.inputValue < value; });
+    if (pos != m_controlPoints.end() && pos->inputValue == inputValue) {
+        throw noise::ExceptionInvalidParam();
     }
-    return static_cast<int>(m_controlPoints.size());
+    return static_cast<int>(pos - m_controlPoints.begin());
 }
 
 double Curve::GetValue(double x, double y, double z) const noexcept {
+    return GetValue(EvalContext(), x, y, z);
+}
+
+double Curve::GetValue(const EvalContext& context, double x, double y, double z) const noexcept {
     assert(m_sourceModules[0] != nullptr && "Source module must be set before calling GetValue");
     assert(m_controlPoints.size() >= 4 && "At least four control points are required for cubic interpolation");
 
-    double sourceValue = m_sourceModules[0]->GetValue(x, y, z);
+    return MapSourceValue(m_sourceModules[0]->GetValue(context, x, y, z));
+}
 
-    int indexPos;
-    for (indexPos = 0; indexPos < static_cast<int>(m_controlPoints.size()); ++indexPos) {
-        if (sourceValue < m_controlPoints[indexPos].inputValue) {
-            break;
-        }
+template <typename Real>
+void Curve::GetValuesImpl(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+    Real* out, int count) const noexcept {
+    assert(m_sourceModules[0] != nullptr && "Source module must be set before calling GetValues");
+    assert(m_controlPoints.size() >= 4 && "At least four control points are required for cubic interpolation");
+
+    m_sourceModules[0]->GetValues(context, x, y, z, out, count);
+    for (int i = 0; i < count; ++i) {
+        out[i] = static_cast<Real>(MapSourceValue(out[i]));
     }
+}
 
-    int index0 = ClampValue(indexPos - 2, 0, static_cast<int>(m_controlPoints.size()) - 1);
-    int index1 = ClampValue(indexPos - 1, 0, static_cast<int>(m_controlPoints.size()) - 1);
-    int index2 = ClampValue(indexPos, 0, static_cast<int>(m_controlPoints.size()) - 1);
-    int index3 = ClampValue(indexPos + 1, 0, static_cast<int>(m_controlPoints.size()) - 1);
+void Curve::GetValues(const double* x, const double* y, const double* z,
+    double* out, int count) const noexcept {
+    GetValuesImpl(EvalContext(), x, y, z, out, count);
+}
 
-    if (index1 == index2) {
-        return m_controlPoints[index1].outputValue;
-    }
+void Curve::GetValues(const float* x, const float* y, const float* z,
+    float* out, int count) const noexcept {
+    GetValuesImpl(EvalContext(), x, y, z, out, count);
+}
 
-    const double input0 = m_controlPoints[index1].inputValue;
-    const double input1 = m_controlPoints[index2].inputValue;
-    const double alpha = (sourceValue - input0) / (input1 - input0);
+void Curve::GetValues(const EvalContext& context, const double* x, const double* y, const double* z,
+    double* out, int count) const noexcept {
+    GetValuesImpl(context, x, y, z, out, count);
+}
+
+void Curve::GetValues(const EvalContext& context, const float* x, const float* y, const float* z,
+    float* out, int count) const noexcept {
+    GetValuesImpl(context, x, y, z, out, count);
+}
+
+double Curve::MapSourceValue(double sourceValue) const noexcept {
+    // Find the first control point with an input value greater than the source
+    // value; the segment that ends at it contains the source value.
+    const int indexPos = FindUpperControlPoint(m_controlPoints.data(),
+        static_cast<int>(m_controlPoints.size()), sourceValue);
+
+    // Below the first control point and above the last one, the curve is flat.
+    if (indexPos == 0) {
+        return m_controlPoints[0].outputValue;
+    }
+    if (indexPos == static_cast<int>(m_controlPoints.size())) {
+        return m_controlPoints[indexPos - 1].outputValue;
+    }
 
-    return CubicInterp(
-        m_controlPoints[index0].outputValue,
-        m_controlPoints[index1].outputValue,
-        m_controlPoints[index2].outputValue,
-        m_controlPoints[index3].outputValue,
-        alpha);
+    // Evaluate the segment as CubicInterp() does.
+    const Segment& segment = m_segments[indexPos - 1];
+    const double alpha = (sourceValue - segment.inputValue) / segment.inputWidth;
+    const double alpha2 = alpha * alpha;
+    const double alpha3 = alpha2 * alpha;
+    return segment.p * alpha3 + segment.q * alpha2 + segment.r * alpha + segment.s;
 }
 
 void Curve::InsertAtPos(int insertionPos, double inputValue, double outputValue) {
@@ -83,4 +158,75 @@ void Curve::InsertAtPos(int insertionPos, double inputValue, double outputValue)
     newPoint.inputValue = inputValue;
     newPoint.outputValue = outputValue;
     m_controlPoints.insert(m_controlPoints.begin() + insertionPos, newPoint);
-}
\ No newline at end of file
+}
+
+ValueRange Curve::GetValueRange() const {
+    const int controlPointCount = static_cast<int>(m_controlPoints.size());
+    if (controlPointCount < 4) {
+        return ValueRange::Unbounded();
+    }
+
+    const ValueRange source = GetSourceModule(0).GetValueRange();
+    double lower = std::numeric_limits<double>::infinity();
+    double upper = -std::numeric_limits<double>::infinity();
+    auto include = [&](double value) {
+        lower = std::min(lower, value);
+        upper = std::max(upper, value);
+    };
+
+    // Below the first control point and above the last one, the curve is flat.
+    if (source.lowerBound < m_controlPoints[0].inputValue) {
+        include(m_controlPoints[0].outputValue);
+    }
+    if (source.upperBound >= m_controlPoints[controlPointCount - 1].inputValue) {
+        include(m_controlPoints[controlPointCount - 1].outputValue);
+    }
+
+    // Between two control points, the curve is a cubic polynomial of the alpha
+    // value (see CubicInterp()); its extremes lie at the ends of the alpha range
+    // covered by the source range or where its derivative is zero.
+    for (int index1 = 0; index1 + 1 < controlPointCount; ++index1) {
+        const int index2 = index1 + 1;
+        const double input0 = m_controlPoints[index1].inputValue;
+        const double input1 = m_controlPoints[index2].inputValue;
+        if (source.upperBound < input0 || source.lowerBound >= input1) {
+            continue;
+        }
+
+        const double n0 = m_controlPoints[std::max(index1 - 1, 0)].outputValue;
+        const double n1 = m_controlPoints[index1].outputValue;
+        const double n2 = m_controlPoints[index2].outputValue;
+        const double n3 = m_controlPoints[std::min(index2 + 1, controlPointCount - 1)].outputValue;
+        const double alphaLower = std::max(0.0, (source.lowerBound - input0) / (input1 - input0));
+        const double alphaUpper = std::min(1.0, (source.upperBound - input0) / (input1 - input0));
+        include(CubicInterp(n0, n1, n2, n3, alphaLower));
+        include(CubicInterp(n0, n1, n2, n3, alphaUpper));
+
+        // Roots of the derivative 3p a^2 + 2q a + r.
+        const double p = (n3 - n2) - (n0 - n1);
+        const double q = (n0 - n1) - p;
+        const double r = n2 - n0;
+        double roots[2];
+        int rootCount = 0;
+        if (p == 0.0) {
+            if (q != 0.0) {
+                roots[rootCount++] = -r / (2.0 * q);
+            }
+        } else {
+            const double discriminant = q * q - 3.0 * p * r;
+            if (discriminant >= 0.0) {
+                const double root = std::sqrt(discriminant);
+                roots[rootCount++] = (-q + root) / (3.0 * p);
+                roots[rootCount++] = (-q - root) / (3.0 * p);
+            }
+        }
+        for (int i = 0; i < rootCount; ++i) {
+            if (roots[i] > alphaLower && roots[i] < alphaUpper) {
+                include(CubicInterp(n0, n1, n2, n3, roots[i]));
+            }
+        }
+    }
+
+    // Widen the bounds slightly to cover rounding in the interpolation.
+    return { lower - 1.0e-12 * (1.0 + std::fabs(lower)), upper + 1.0e-12 * (1.0 + std::fabs(upper)) };
+}
@@ -0,0 +1,67 @@
+// graphreplica.cpp
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+
+#include "noise/module/graphreplica.h"
+
+using namespace noise::module;
+
+void GraphReplica::Replicate(const Module& root) {
+    m_copies.clear();
+    m_copyOf.clear();
+    m_root = nullptr;
+
+    try {
+        std::set<const Module*> inProgress;
+        m_root = &CopyModule(root, inProgress);
+    } catch (...) {
+        m_copies.clear();
+        m_copyOf.clear();
+        m_root = nullptr;
+        throw;
+    }
+}
+
+Module& GraphReplica::GetCopy(const Module& original) {
+    const auto found = m_copyOf.find(&original);
+    if (found == m_copyOf.end() || found->second == nullptr) {
+        throw noise::ExceptionInvalidParam();
+    }
+    return *found->second;
+}
+
+const Module& GraphReplica::CopyModule(const Module& module, std::set<const Module*>& inProgress) {
+    const auto found = m_copyOf.find(&module);
+    if (found != m_copyOf.end()) {
+        return found->second != nullptr ? *found->second : module;
+    }
+
+    // A module that cannot be copied keeps its own source modules, so the walk
+    // stops there.
+    std::unique_ptr<Module> copy = module.Clone();
+    if (copy == nullptr) {
+        m_copyOf.emplace(&module, nullptr);
+        return module;
+    }
+
+    if (!inProgress.insert(&module).second) {
+        throw noise::ExceptionInvalidParam();
+    }
+    for (int i = 0; i < module.GetSourceModuleCount(); ++i) {
+        copy->SetSourceModule(i, CopyModule(module.GetSourceModule(i), inProgress));
+    }
+    inProgress.erase(&module);
+
+    Module* const result = copy.get();
+    m_copies.push_back(std::move(copy));
+    m_copyOf.emplace(&module, result);
+    return *result;
+}
@@ -24,29 +24,242 @@
 
 using namespace noise::module;
 
+namespace {
+
+    // Number of input values that GetValues() passes to the batch
+    // gradient-coherent-noise function at a time.
+    constexpr int BATCH_BLOCK_SIZE = 256;
+
+}
+
+template <noise::NoiseQuality Q>
+double Perlin::CalcValue(const EvalContext& context, double x, double y, double z) const noexcept {
+    double value = 0.0;
+    double signal = 0.0;
+    double curPersistence = 1.0;
+
+    x *= m_frequency;
+    y *= m_frequency;
+    z *= m_frequency;
+
+    // Every octave of an input value on the plane y = 0 (e.g., from a planar
+    // noise map) stays on that plane, so the cheaper 2D noise function applies.
+    const bool isPlanar = (y == 0.0);
+
+    // As in GetValues(), octaves that the samples cannot resolve are faded out
+    // and skipped.
+    double octaveWeights[PERLIN_MAX_OCTAVE];
+    const int octaveCount = context.GetOctaveWeights(m_frequency, m_lacunarity, m_evaluatedOctaveCount, octaveWeights);
+    if (context.stats != nullptr) {
+        context.stats->octaveCount += static_cast<std::uint64_t>(octaveCount);
+    }
+
+    for (int curOctave = 0; curOctave < octaveCount; ++curOctave) {
+        double nx = MakeInt32Range(x);
+        double ny = MakeInt32Range(y);
+        double nz = MakeInt32Range(z);
+
+        int32 seed = (m_seed + curOctave) & 0xffffffff;
+        signal = isPlanar ? GradientCoherentNoise2D<Q>(nx, nz, seed)
+            : GradientCoherentNoise3D<Q>(nx, ny, nz, seed);
+        value += signal * (curPersistence * octaveWeights[curOctave]);
+
+        x *= m_lacunarity;
+        y *= m_lacunarity;
+        z *= m_lacunarity;
+        curPersistence *= m_persistence;
+    }
+
+    return value;
+}
+
 double Perlin::GetValue(double x, double y, double z) const noexcept {
+    return GetValue(EvalContext(), x, y, z);
+}
+
+double Perlin::GetValue(const EvalContext& context, double x, double y, double z) const noexcept {
+    switch (m_noiseQuality) {
+        case NoiseQuality::QUALITY_FAST:
+            return CalcValue<NoiseQuality::QUALITY_FAST>(context, x, y, z);
+        case NoiseQuality::QUALITY_STD:
+            return CalcValue<NoiseQuality::QUALITY_STD>(context, x, y, z);
+        case NoiseQuality::QUALITY_BEST:
+        default:
+            return CalcValue<NoiseQuality::QUALITY_BEST>(context, x, y, z);
+    }
+}
+
+template <noise::NoiseQuality Q>
+double Perlin::CalcValue(double x, double y, double z,
+    double& dx, double& dy, double& dz) const noexcept {
     double value = 0.0;
     double signal = 0.0;
     double curPersistence = 1.0;
+    double curFrequency = m_frequency;
+    dx = 0.0;
+    dy = 0.0;
+    dz = 0.0;
 
     x *= m_frequency;
     y *= m_frequency;
     z *= m_frequency;
 
-    for (int curOctave = 0; curOctave < m_octaveCount; ++curOctave) {
+    for (int curOctave = 0; curOctave < m_evaluatedOctaveCount; ++curOctave) {
         double nx = MakeInt32Range(x);
         double ny = MakeInt32Range(y);
         double nz = MakeInt32Range(z);
 
         int32 seed = (m_seed + curOctave) & 0xffffffff;
-        signal = GradientCoherentNoise3D(nx, ny, nz, seed, m_noiseQuality);
+        double sdx, sdy, sdz;
+        signal = GradientCoherentNoise3D<Q>(nx, ny, nz, sdx, sdy, sdz, seed);
         value += signal * curPersistence;
 
+        // The octave samples the noise at the input coordinates times its
+        // frequency, which scales its derivatives by that frequency.
+        const double scale = curPersistence * curFrequency;
+        dx += sdx * scale;
+        dy += sdy * scale;
+        dz += sdz * scale;
+
         x *= m_lacunarity;
         y *= m_lacunarity;
         z *= m_lacunarity;
         curPersistence *= m_persistence;
+        curFrequency *= m_lacunarity;
     }
 
     return value;
-}
\ No newline at end of file
+}
+
+double Perlin::GetValue(double x, double y, double z,
+    double& dx, double& dy, double& dz) const noexcept {
+    switch (m_noiseQuality) {
+        case NoiseQuality::QUALITY_FAST:
+            return CalcValue<NoiseQuality::QUALITY_FAST>(x, y, z, dx, dy, dz);
+        case NoiseQuality::QUALITY_STD:
+            return CalcValue<NoiseQuality::QUALITY_STD>(x, y, z, dx, dy, dz);
+        case NoiseQuality::QUALITY_BEST:
+        default:
+            return CalcValue<NoiseQuality::QUALITY_BEST>(x, y, z, dx, dy, dz);
+    }
+}
+
+template <noise::NoiseQuality Q, typename Real>
+void Perlin::CalcValues(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+    Real* out, int count) const noexcept {
+    Real px[BATCH_BLOCK_SIZE], py[BATCH_BLOCK_SIZE], pz[BATCH_BLOCK_SIZE];
+    Real rx[BATCH_BLOCK_SIZE], ry[BATCH_BLOCK_SIZE], rz[BATCH_BLOCK_SIZE];
+    Real signal[BATCH_BLOCK_SIZE];
+    const Real frequency = static_cast<Real>(m_frequency);
+    const Real lacunarity = static_cast<Real>(m_lacunarity);
+    const Real persistence = static_cast<Real>(m_persistence);
+
+    // Octaves that the samples cannot resolve are faded out and skipped.
+    double octaveWeights[PERLIN_MAX_OCTAVE];
+    const int octaveCount = context.GetOctaveWeights(m_frequency, m_lacunarity, m_evaluatedOctaveCount, octaveWeights);
+    if (context.stats != nullptr) {
+        context.stats->octaveCount += static_cast<std::uint64_t>(count) * static_cast<std::uint64_t>(octaveCount);
+    }
+
+    for (int start = 0; start < count; start += BATCH_BLOCK_SIZE) {
+        const int blockCount = std::min(BATCH_BLOCK_SIZE, count - start);
+        Real* value = out + start;
+        bool isPlanar = true;
+        for (int i = 0; i < blockCount; ++i) {
+            px[i] = x[start + i] * frequency;
+            py[i] = y[start + i] * frequency;
+            pz[i] = z[start + i] * frequency;
+            isPlanar = isPlanar && (py[i] == Real(0.0));
+            value[i] = Real(0.0);
+        }
+
+        Real curPersistence = Real(1.0);
+        for (int curOctave = 0; curOctave < octaveCount; ++curOctave) {
+            const Real* nx = MakeInt32Range(px, rx, blockCount);
+            const Real* ny = MakeInt32Range(py, ry, blockCount);
+            const Real* nz = MakeInt32Range(pz, rz, blockCount);
+
+            int32 seed = (m_seed + curOctave) & 0xffffffff;
+            if (isPlanar) {
+                GradientCoherentNoise2D<Q>(nx, nz, signal, blockCount, seed);
+            } else {
+                GradientCoherentNoise3D<Q>(nx, ny, nz, signal, blockCount, seed);
+            }
+
+            const Real octavePersistence = curPersistence * static_cast<Real>(octaveWeights[curOctave]);
+            for (int i = 0; i < blockCount; ++i) {
+                value[i] += signal[i] * octavePersistence;
+                px[i] *= lacunarity;
+                py[i] *= lacunarity;
+                pz[i] *= lacunarity;
+            }
+            curPersistence *= persistence;
+        }
+    }
+}
+
+template <typename Real>
+void Perlin::GetValuesImpl(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+    Real* out, int count) const noexcept {
+    switch (m_noiseQuality) {
+        case NoiseQuality::QUALITY_FAST:
+            CalcValues<NoiseQuality::QUALITY_FAST>(context, x, y, z, out, count);
+            break;
+        case NoiseQuality::QUALITY_STD:
+            CalcValues<NoiseQuality::QUALITY_STD>(context, x, y, z, out, count);
+            break;
+        case NoiseQuality::QUALITY_BEST:
+        default:
+            CalcValues<NoiseQuality::QUALITY_BEST>(context, x, y, z, out, count);
+            break;
+    }
+}
+
+void Perlin::GetValues(const double* x, const double* y, const double* z,
+    double* out, int count) const noexcept {
+    GetValuesImpl(EvalContext(), x, y, z, out, count);
+}
+
+void Perlin::GetValues(const float* x, const float* y, const float* z,
+    float* out, int count) const noexcept {
+    GetValuesImpl(EvalContext(), x, y, z, out, count);
+}
+
+void Perlin::GetValues(const EvalContext& context, const double* x, const double* y, const double* z,
+    double* out, int count) const noexcept {
+    GetValuesImpl(context, x, y, z, out, count);
+}
+
+void Perlin::GetValues(const EvalContext& context, const float* x, const float* y, const float* z,
+    float* out, int count) const noexcept {
+    GetValuesImpl(context, x, y, z, out, count);
+}
+
+ValueRange Perlin::GetValueRange() const {
+    double bound = 0.0;
+    double curPersistence = 1.0;
+    for (int curOctave = 0; curOctave < m_evaluatedOctaveCount; ++curOctave) {
+        bound += GRADIENT_NOISE_BOUND * std::fabs(curPersistence);
+        curPersistence *= m_persistence;
+    }
+    return { -bound, bound };
+}
+
+void Perlin::CalcOctaveTruncation() noexcept {
+    // The signal of each octave is bounded by GRADIENT_NOISE_BOUND.
+    double octaveBounds[PERLIN_MAX_OCTAVE];
+    double curPersistence = 1.0;
+    for (int curOctave = 0; curOctave < m_octaveCount; ++curOctave) {
+        octaveBounds[curOctave] = GRADIENT_NOISE_BOUND * std::fabs(curPersistence);
+        curPersistence *= m_persistence;
+    }
+    // Omit the highest octaves while the sum of their bounds stays within the
+    // tolerance.
+    m_evaluatedOctaveCount = m_octaveCount;
+    m_truncationError = 0.0;
+    while (m_evaluatedOctaveCount > 1
+        && m_truncationError + octaveBounds[m_evaluatedOctaveCount - 1] <= m_tolerance) {
+        m_truncationError += octaveBounds[--m_evaluatedOctaveCount];
+    }
+    InvalidateValueRanges();
+}
@@ -25,6 +25,14 @@
 
 using namespace noise::module;
 
+namespace {
+
+    // Number of input values that GetValues() passes to the batch
+    // gradient-coherent-noise function at a time.
+    constexpr int BATCH_BLOCK_SIZE = 256;
+
+}
+
 void RidgedMulti::CalcSpectralWeights() noexcept {
     double h = 1.0;
     double frequency = 1.0;
@@ -34,7 +42,88 @@ void RidgedMulti::CalcSpectralWeights() noexcept {
     }
 }
 
+template <noise::NoiseQuality Q>
+double RidgedMulti::CalcValue(const EvalContext& context, double x, double y, double z) const noexcept {
+    x *= m_frequency;
+    y *= m_frequency;
+    z *= m_frequency;
+
+    // Every octave of an input value on the plane y = 0 (e.g., from a planar
+    // noise map) stays on that plane, so the cheaper 2D noise function applies.
+    const bool isPlanar = (y == 0.0);
+
+    double signal = 0.0;
+    double value = 0.0;
+    double weight = 1.0;
+
+    double offset = 1.0;
+    double gain = 2.0;
+
+    // As in GetValues(), octaves that the samples cannot resolve are faded out
+    // and skipped.
+    double octaveWeights[RIDGED_MAX_OCTAVE];
+    const int octaveCount = context.GetOctaveWeights(m_frequency, m_lacunarity, m_evaluatedOctaveCount, octaveWeights);
+
+    int curOctave = 0;
+    while (curOctave < octaveCount) {
+        double nx = MakeInt32Range(x);
+        double ny = MakeInt32Range(y);
+        double nz = MakeInt32Range(z);
+
+        int seed = (m_seed + curOctave) & 0x7fffffff;
+        signal = isPlanar ? GradientCoherentNoise2D<Q>(nx, nz, seed)
+            : GradientCoherentNoise3D<Q>(nx, ny, nz, seed);
+        signal = std::fabs(signal);
+        signal = offset - signal;
+        signal *= signal;
+        signal *= weight;
+
+        weight = signal * gain;
+        if (weight > 1.0) {
+            weight = 1.0;
+        }
+        if (weight < 0.0) {
+            weight = 0.0;
+        }
+
+        value += (signal * (m_pSpectralWeights[curOctave] * octaveWeights[curOctave]));
+        ++curOctave;
+
+        // Every later octave is multiplied by a zero weight, so it contributes nothing.
+        if (weight == 0.0) {
+            break;
+        }
+
+        x *= m_lacunarity;
+        y *= m_lacunarity;
+        z *= m_lacunarity;
+    }
+    if (context.stats != nullptr) {
+        context.stats->octaveCount += static_cast<std::uint64_t>(curOctave);
+    }
+
+    return (value * 1.25) - 1.0;
+}
+
 double RidgedMulti::GetValue(double x, double y, double z) const noexcept {
+    return GetValue(EvalContext(), x, y, z);
+}
+
+double RidgedMulti::GetValue(const EvalContext& context, double x, double y, double z) const noexcept {
+    switch (m_noiseQuality) {
+        case NoiseQuality::QUALITY_FAST:
+            return CalcValue<NoiseQuality::QUALITY_FAST>(context, x, y, z);
+        case NoiseQuality::QUALITY_STD:
+            return CalcValue<NoiseQuality::QUALITY_STD>(context, x, y, z);
+        case NoiseQuality::QUALITY_BEST:
+        default:
+            return CalcValue<NoiseQuality::QUALITY_BEST>(context, x, y, z);
+    }
+}
+
+template <noise::NoiseQuality Q>
+double RidgedMulti::CalcValue(double x, double y, double z,
+    double& dx, double& dy, double& dz) const noexcept {
     x *= m_frequency;
     y *= m_frequency;
     z *= m_frequency;
@@ -42,17 +131,34 @@ double RidgedMulti::GetValue(double x, double y, double z) const noexcept {
     double signal = 0.0;
     double value = 0.0;
     double weight = 1.0;
+    double curFrequency = m_frequency;
 
     double offset = 1.0;
     double gain = 2.0;
 
-    for (int curOctave = 0; curOctave < m_octaveCount; curOctave++) {
+    // Partial derivatives of the output value and of the weight.
+    double vdx = 0.0, vdy = 0.0, vdz = 0.0;
+    double wdx = 0.0, wdy = 0.0, wdz = 0.0;
+
+    for (int curOctave = 0; curOctave < m_evaluatedOctaveCount; curOctave++) {
         double nx = MakeInt32Range(x);
         double ny = MakeInt32Range(y);
         double nz = MakeInt32Range(z);
 
         int seed = (m_seed + curOctave) & 0x7fffffff;
-        signal = GradientCoherentNoise3D(nx, ny, nz, seed, m_noiseQuality);
+        double ndx, ndy, ndz;
+        signal = GradientCoherentNoise3D<Q>(nx, ny, nz, ndx, ndy, ndz, seed);
+
+        // signal = (offset - |n|)^2 * weight, so
+        // d(signal) = -2 (offset - |n|) sign(n) dn * weight + (offset - |n|)^2 d(weight),
+        // where the octave frequency scales dn.
+        const double ridge = offset - std::fabs(signal);
+        const double noiseScale = -2.0 * ridge * (signal < 0.0 ? -1.0 : 1.0) * weight * curFrequency;
+        const double ridge2 = ridge * ridge;
+        const double sdx = ndx * noiseScale + ridge2 * wdx;
+        const double sdy = ndy * noiseScale + ridge2 * wdy;
+        const double sdz = ndz * noiseScale + ridge2 * wdz;
+
         signal = std::fabs(signal);
         signal = offset - signal;
         signal *= signal;
@@ -66,12 +172,181 @@ double RidgedMulti::GetValue(double x, double y, double z) const noexcept {
             weight = 0.0;
         }
 
+        // The weight only varies where it is not clamped.
+        const double weightScale = (weight > 0.0 && weight < 1.0) ? gain : 0.0;
+        wdx = sdx * weightScale;
+        wdy = sdy * weightScale;
+        wdz = sdz * weightScale;
+
         value += (signal * m_pSpectralWeights[curOctave]);
+        vdx += sdx * m_pSpectralWeights[curOctave];
+        vdy += sdy * m_pSpectralWeights[curOctave];
+        vdz += sdz * m_pSpectralWeights[curOctave];
+
+        // Every later octave is multiplied by a zero weight, so it contributes nothing.
+        if (weight == 0.0) {
+            break;
+        }
 
         x *= m_lacunarity;
         y *= m_lacunarity;
         z *= m_lacunarity;
+        curFrequency *= m_lacunarity;
     }
 
+    dx = vdx * 1.25;
+    dy = vdy * 1.25;
+    dz = vdz * 1.25;
     return (value * 1.25) - 1.0;
-}
\ No newline at end of file
+}
+
+double RidgedMulti::GetValue(double x, double y, double z,
+    double& dx, double& dy, double& dz) const noexcept {
+    switch (m_noiseQuality) {
+        case NoiseQuality::QUALITY_FAST:
+            return CalcValue<NoiseQuality::QUALITY_FAST>(x, y, z, dx, dy, dz);
+        case NoiseQuality::QUALITY_STD:
+            return CalcValue<NoiseQuality::QUALITY_STD>(x, y, z, dx, dy, dz);
+        case NoiseQuality::QUALITY_BEST:
+        default:
+            return CalcValue<NoiseQuality::QUALITY_BEST>(x, y, z, dx, dy, dz);
+    }
+}
+
+template <noise::NoiseQuality Q, typename Real>
+void RidgedMulti::CalcValues(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+    Real* out, int count) const noexcept {
+    Real px[BATCH_BLOCK_SIZE], py[BATCH_BLOCK_SIZE], pz[BATCH_BLOCK_SIZE];
+    Real rx[BATCH_BLOCK_SIZE], ry[BATCH_BLOCK_SIZE], rz[BATCH_BLOCK_SIZE];
+    Real signal[BATCH_BLOCK_SIZE], weight[BATCH_BLOCK_SIZE];
+    const Real frequency = static_cast<Real>(m_frequency);
+    const Real lacunarity = static_cast<Real>(m_lacunarity);
+
+    const Real offset = Real(1.0);
+    const Real gain = Real(2.0);
+
+    // Octaves that the samples cannot resolve are faded out and skipped.
+    double octaveWeights[RIDGED_MAX_OCTAVE];
+    const int octaveCount = context.GetOctaveWeights(m_frequency, m_lacunarity, m_evaluatedOctaveCount, octaveWeights);
+
+    for (int start = 0; start < count; start += BATCH_BLOCK_SIZE) {
+        const int blockCount = std::min(BATCH_BLOCK_SIZE, count - start);
+        Real* value = out + start;
+        bool isPlanar = true;
+        for (int i = 0; i < blockCount; ++i) {
+            px[i] = x[start + i] * frequency;
+            py[i] = y[start + i] * frequency;
+            pz[i] = z[start + i] * frequency;
+            isPlanar = isPlanar && (py[i] == Real(0.0));
+            value[i] = Real(0.0);
+            weight[i] = Real(1.0);
+        }
+
+        for (int curOctave = 0; curOctave < octaveCount; curOctave++) {
+            const Real* nx = MakeInt32Range(px, rx, blockCount);
+            const Real* ny = MakeInt32Range(py, ry, blockCount);
+            const Real* nz = MakeInt32Range(pz, rz, blockCount);
+
+            int seed = (m_seed + curOctave) & 0x7fffffff;
+            if (isPlanar) {
+                GradientCoherentNoise2D<Q>(nx, nz, signal, blockCount, seed);
+            } else {
+                GradientCoherentNoise3D<Q>(nx, ny, nz, signal, blockCount, seed);
+            }
+            if (context.stats != nullptr) {
+                context.stats->octaveCount += static_cast<std::uint64_t>(blockCount);
+            }
+
+            const Real spectralWeight = static_cast<Real>(m_pSpectralWeights[curOctave] * octaveWeights[curOctave]);
+            for (int i = 0; i < blockCount; ++i) {
+                Real curSignal = offset - std::fabs(signal[i]);
+                curSignal *= curSignal;
+                curSignal *= weight[i];
+
+                // Weight successive contributions by the previous signal.
+                weight[i] = std::clamp(curSignal * gain, Real(0.0), Real(1.0));
+
+                value[i] += (curSignal * spectralWeight);
+
+                px[i] *= lacunarity;
+                py[i] *= lacunarity;
+                pz[i] *= lacunarity;
+            }
+
+            // Every later octave is multiplied by a zero weight at every input
+            // value of the block, so it contributes nothing.
+            if (std::all_of(weight, weight + blockCount, [](Real w) { return w == Real(0.0); })) {
+                break;
+            }
+        }
+
+        for (int i = 0; i < blockCount; ++i) {
+            value[i] = (value[i] * Real(1.25)) - Real(1.0);
+        }
+    }
+}
+
+template <typename Real>
+void RidgedMulti::GetValuesImpl(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+    Real* out, int count) const noexcept {
+    switch (m_noiseQuality) {
+        case NoiseQuality::QUALITY_FAST:
+            CalcValues<NoiseQuality::QUALITY_FAST>(context, x, y, z, out, count);
+            break;
+        case NoiseQuality::QUALITY_STD:
+            CalcValues<NoiseQuality::QUALITY_STD>(context, x, y, z, out, count);
+            break;
+        case NoiseQuality::QUALITY_BEST:
+        default:
+            CalcValues<NoiseQuality::QUALITY_BEST>(context, x, y, z, out, count);
+            break;
+    }
+}
+
+void RidgedMulti::GetValues(const double* x, const double* y, const double* z,
+    double* out, int count) const noexcept {
+    GetValuesImpl(EvalContext(), x, y, z, out, count);
+}
+
+void RidgedMulti::GetValues(const float* x, const float* y, const float* z,
+    float* out, int count) const noexcept {
+    GetValuesImpl(EvalContext(), x, y, z, out, count);
+}
+
+void RidgedMulti::GetValues(const EvalContext& context, const double* x, const double* y, const double* z,
+    double* out, int count) const noexcept {
+    GetValuesImpl(context, x, y, z, out, count);
+}
+
+void RidgedMulti::GetValues(const EvalContext& context, const float* x, const float* y, const float* z,
+    float* out, int count) const noexcept {
+    GetValuesImpl(context, x, y, z, out, count);
+}
+
+ValueRange RidgedMulti::GetValueRange() const {
+    // Each octave's signal is (offset - |n|)^2 times a weight in [0, 1]. With an
+    // offset of 1.0 and |n| <= GRADIENT_NOISE_BOUND < 2.0, the signal lies in
+    // [0, 1], and the spectral weights are positive.
+    double upper = 0.0;
+    for (int curOctave = 0; curOctave < m_evaluatedOctaveCount; ++curOctave) {
+        upper += m_pSpectralWeights[curOctave];
+    }
+    return { -1.0, (upper * 1.25) - 1.0 };
+}
+
+void RidgedMulti::CalcOctaveTruncation() noexcept {
+    // The signal of each octave lies in [0, 1] and is scaled by 1.25 on output.
+    double octaveBounds[RIDGED_MAX_OCTAVE];
+    for (int curOctave = 0; curOctave < m_octaveCount; ++curOctave) {
+        octaveBounds[curOctave] = 1.25 * m_pSpectralWeights[curOctave];
+    }
+    // Omit the highest octaves while the sum of their bounds stays within the
+    // tolerance.
+    m_evaluatedOctaveCount = m_octaveCount;
+    m_truncationError = 0.0;
+    while (m_evaluatedOctaveCount > 1
+        && m_truncationError + octaveBounds[m_evaluatedOctaveCount - 1] <= m_tolerance) {
+        m_truncationError += octaveBounds[--m_evaluatedOctaveCount];
+    }
+    InvalidateValueRanges();
+}
@@ -22,6 +22,7 @@
 // - Moved constructor to header as inline.
 // - Moved GetValue inline implementation to header.
 
+#include <algorithm>
 #include "noise/interp.h"
 #include "noise/module/select.h"
 
@@ -35,42 +36,147 @@ const Module& Select::GetControlModule() const {
 }
 
 double Select::GetValue(double x, double y, double z) const noexcept {
+    return GetValue(EvalContext(), x, y, z);
+}
+
+double Select::GetValue(const EvalContext& context, double x, double y, double z) const noexcept {
     assert(m_sourceModules[0] != nullptr && "Source module 0 must be set before calling GetValue");
     assert(m_sourceModules[1] != nullptr && "Source module 1 must be set before calling GetValue");
     assert(m_sourceModules[2] != nullptr && "Control module (source module 2) must be set before calling GetValue");
 
-    double controlValue = m_sourceModules[2]->GetValue(x, y, z);
+    return GetSelectedValue(context, m_sourceModules[2]->GetValue(context, x, y, z), x, y, z);
+}
+
+template <typename Real>
+void Select::GetValuesImpl(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+    Real* out, int count) const noexcept {
+    assert(m_sourceModules[0] != nullptr && "Source module 0 must be set before calling GetValues");
+    assert(m_sourceModules[1] != nullptr && "Source module 1 must be set before calling GetValues");
+    assert(m_sourceModules[2] != nullptr && "Control module (source module 2) must be set before calling GetValues");
+
+    // Skip the control module if its output range selects one source module.
+    const int selectedSource = m_selectedSource.Get([this] {
+        return GetSelectedSource(m_sourceModules[2]->GetValueRange());
+    });
+    if (selectedSource >= 0) {
+        m_sourceModules[selectedSource]->GetValues(context, x, y, z, out, count);
+        return;
+    }
+
+    // Partition each block of input values by the source modules they select,
+    // then evaluate each source module once for the input values of the block
+    // that need it.
+    SelectionRegion regions[GATHER_BLOCK_SIZE];
+    double alphas[GATHER_BLOCK_SIZE];
+    Real values1[GATHER_BLOCK_SIZE];
+    int indices[GATHER_BLOCK_SIZE];
+    for (int start = 0; start < count; start += GATHER_BLOCK_SIZE) {
+        const int blockCount = std::min(GATHER_BLOCK_SIZE, count - start);
+        const Real* blockX = x + start;
+        const Real* blockY = y + start;
+        const Real* blockZ = z + start;
+        Real* blockOut = out + start;
+        m_sourceModules[2]->GetValues(context, blockX, blockY, blockZ, blockOut, blockCount);
+        for (int i = 0; i < blockCount; ++i) {
+            regions[i] = GetSelectionRegion(blockOut[i], alphas[i]);
+        }
+
+        // The control values are no longer needed, so the output values from
+        // source module 0 replace them.
+        Real* values[2] = { blockOut, values1 };
+        for (int source = 0; source < 2; ++source) {
+            const SelectionRegion otherSource = (source == 0) ? SelectionRegion::Source1 : SelectionRegion::Source0;
+            int indexCount = 0;
+            for (int i = 0; i < blockCount; ++i) {
+                if (regions[i] != otherSource) {
+                    indices[indexCount++] = i;
+                }
+            }
+            GetValuesAt(*m_sourceModules[source], context, indices, indexCount,
+                blockX, blockY, blockZ, values[source], blockCount);
+        }
+
+        for (int i = 0; i < blockCount; ++i) {
+            blockOut[i] = static_cast<Real>(GetRegionValue(regions[i], alphas[i], blockOut[i], values1[i]));
+        }
+    }
+}
+
+void Select::GetValues(const double* x, const double* y, const double* z,
+    double* out, int count) const noexcept {
+    GetValuesImpl(EvalContext(), x, y, z, out, count);
+}
+
+void Select::GetValues(const float* x, const float* y, const float* z,
+    float* out, int count) const noexcept {
+    GetValuesImpl(EvalContext(), x, y, z, out, count);
+}
+
+void Select::GetValues(const EvalContext& context, const double* x, const double* y, const double* z,
+    double* out, int count) const noexcept {
+    GetValuesImpl(context, x, y, z, out, count);
+}
+
+void Select::GetValues(const EvalContext& context, const float* x, const float* y, const float* z,
+    float* out, int count) const noexcept {
+    GetValuesImpl(context, x, y, z, out, count);
+}
+
+double Select::GetSelectedValue(const EvalContext& context, double controlValue,
+    double x, double y, double z) const noexcept {
+    double alpha = 0.0;
+    const SelectionRegion region = GetSelectionRegion(controlValue, alpha);
+    const double value0 = (region != SelectionRegion::Source1) ? m_sourceModules[0]->GetValue(context, x, y, z) : 0.0;
+    const double value1 = (region != SelectionRegion::Source0) ? m_sourceModules[1]->GetValue(context, x, y, z) : 0.0;
+    return GetRegionValue(region, alpha, value0, value1);
+}
+
+Select::SelectionRegion Select::GetSelectionRegion(double controlValue, double& alpha) const noexcept {
     if (m_edgeFalloff > 0.0) {
         if (controlValue < (m_lowerBound - m_edgeFalloff)) {
-            return m_sourceModules[0]->GetValue(x, y, z);
+            return SelectionRegion::Source0;
         } else if (controlValue < (m_lowerBound + m_edgeFalloff)) {
             double lowerCurve = (m_lowerBound - m_edgeFalloff);
             double upperCurve = (m_lowerBound + m_edgeFalloff);
-            double alpha = SCurve3((controlValue - lowerCurve) / (upperCurve - lowerCurve));
-            return LinearInterp(m_sourceModules[0]->GetValue(x, y, z),
-                m_sourceModules[1]->GetValue(x, y, z),
-                alpha);
+            alpha = SCurve3((controlValue - lowerCurve) / (upperCurve - lowerCurve));
+            return (alpha == 0.0) ? SelectionRegion::Source0
+                : (alpha == 1.0) ? SelectionRegion::Source1
+                : SelectionRegion::LowerEdge;
         } else if (controlValue < (m_upperBound - m_edgeFalloff)) {
-            return m_sourceModules[1]->GetValue(x, y, z);
+            return SelectionRegion::Source1;
         } else if (controlValue < (m_upperBound + m_edgeFalloff)) {
             double lowerCurve = (m_upperBound - m_edgeFalloff);
             double upperCurve = (m_upperBound + m_edgeFalloff);
-            double alpha = SCurve3((controlValue - lowerCurve) / (upperCurve - lowerCurve));
-            return LinearInterp(m_sourceModules[1]->GetValue(x, y, z),
-                m_sourceModules[0]->GetValue(x, y, z),
-                alpha);
+            alpha = SCurve3((controlValue - lowerCurve) / (upperCurve - lowerCurve));
+            return (alpha == 0.0) ? SelectionRegion::Source1
+                : (alpha == 1.0) ? SelectionRegion::Source0
+                : SelectionRegion::UpperEdge;
         } else {
-            return m_sourceModules[0]->GetValue(x, y, z);
+            return SelectionRegion::Source0;
         }
     } else {
         if (controlValue < m_lowerBound || controlValue > m_upperBound) {
-            return m_sourceModules[0]->GetValue(x, y, z);
+            return SelectionRegion::Source0;
         } else {
-            return m_sourceModules[1]->GetValue(x, y, z);
+            return SelectionRegion::Source1;
         }
     }
 }
 
+double Select::GetRegionValue(SelectionRegion region, double alpha,
+    double value0, double value1) noexcept {
+    switch (region) {
+        case SelectionRegion::Source0:
+            return value0;
+        case SelectionRegion::Source1:
+            return value1;
+        case SelectionRegion::LowerEdge:
+            return LinearInterp(value0, value1, alpha);
+        default:
+            return LinearInterp(value1, value0, alpha);
+    }
+}
+
 void Select::SetBounds(double lowerBound, double upperBound) {
     assert(lowerBound < upperBound);
 
@@ -85,4 +191,43 @@ void Select::SetEdgeFalloff(double edgeFalloff) noexcept {
     // Make sure that the edge falloff curves do not overlap.
     double boundSize = m_upperBound - m_lowerBound;
     m_edgeFalloff = (edgeFalloff > boundSize / 2) ? boundSize / 2 : edgeFalloff;
-}
\ No newline at end of file
+    InvalidateValueRanges();
+}
+
+int Select::GetSelectedSource(const ValueRange& controlRange) const noexcept {
+    // Follows GetSelectedValue(), for the lowest and highest control values.
+    if (m_edgeFalloff > 0.0) {
+        if (controlRange.upperBound < (m_lowerBound - m_edgeFalloff)
+            || controlRange.lowerBound >= (m_upperBound + m_edgeFalloff)) {
+            return 0;
+        }
+        if (controlRange.lowerBound >= (m_lowerBound + m_edgeFalloff)
+            && controlRange.upperBound < (m_upperBound - m_edgeFalloff)) {
+            return 1;
+        }
+    } else {
+        if (controlRange.upperBound < m_lowerBound || controlRange.lowerBound > m_upperBound) {
+            return 0;
+        }
+        if (controlRange.lowerBound >= m_lowerBound && controlRange.upperBound <= m_upperBound) {
+            return 1;
+        }
+    }
+    return -1;
+}
+
+ValueRange Select::GetValueRange() const {
+    const ValueRange source0 = GetSourceModule(0).GetValueRange();
+    const ValueRange source1 = GetSourceModule(1).GetValueRange();
+
+    // The edge falloff only blends between the two output values, so its output
+    // values stay within the union of both ranges.
+    switch (GetSelectedSource(GetSourceModule(2).GetValueRange())) {
+        case 0:
+            return source0;
+        case 1:
+            return source1;
+        default:
+            return source0.Union(source1);
+    }
+}
@@ -25,31 +25,89 @@
 // - Removed destructor since std::vector handles cleanup.
 // - Removed dependency on misc.h since ClampValue is no longer used.
 
+#include <algorithm>
+#include <cmath>
 #include "noise/interp.h"
 #include "noise/module/terrace.h"
 
 using namespace noise::module;
 
+namespace {
+
+    // Returns the index of the first control point greater than the given
+    // value, or the number of control points if there is none (as
+    // std::upper_bound() does). The search halves the range without branching
+    // on the comparisons, which mispredict for noise values.
+    int FindUpperControlPoint(const double* controlPoints, int count, double value) noexcept {
+        if (count == 0) {
+            return 0;
+        }
+        const double* base = controlPoints;
+        while (count > 1) {
+            const int half = count / 2;
+            base = (value < base[half]) ? base : base + half;
+            count -= half;
+        }
+        return static_cast<int>(base - controlPoints) + (value < *base ? 0 : 1);
+    }
+
+}
+
 void Terrace::AddControlPoint(double value) {
     int insertionPos = FindInsertionPos(value);
     InsertAtPos(insertionPos, value);
+    InvalidateValueRanges();
 }
 
 double Terrace::GetValue(double x, double y, double z) const noexcept {
+    return GetValue(EvalContext(), x, y, z);
+}
+
+double Terrace::GetValue(const EvalContext& context, double x, double y, double z) const noexcept {
     assert(m_sourceModules[0] != nullptr && "Source module must be set before calling GetValue");
     assert(m_controlPoints.size() >= 2 && "At least two control points are required");
 
-    // Get the output value from the source module.
-    double sourceModuleValue = m_sourceModules[0]->GetValue(x, y, z);
+    // Get the output value from the source module and map it onto the curve.
+    return MapSourceValue(m_sourceModules[0]->GetValue(context, x, y, z));
+}
+
+template <typename Real>
+void Terrace::GetValuesImpl(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+    Real* out, int count) const noexcept {
+    assert(m_sourceModules[0] != nullptr && "Source module must be set before calling GetValues");
+    assert(m_controlPoints.size() >= 2 && "At least two control points are required");
+
+    m_sourceModules[0]->GetValues(context, x, y, z, out, count);
+    for (int i = 0; i < count; ++i) {
+        out[i] = static_cast<Real>(MapSourceValue(out[i]));
+    }
+}
+
+void Terrace::GetValues(const double* x, const double* y, const double* z,
+    double* out, int count) const noexcept {
+    GetValuesImpl(EvalContext(), x, y, z, out, count);
+}
+
+void Terrace::GetValues(const float* x, const float* y, const float* z,
+    float* out, int count) const noexcept {
+    GetValuesImpl(EvalContext(), x, y, z, out, count);
+}
+
+void Terrace::GetValues(const EvalContext& context, const double* x, const double* y, const double* z,
+    double* out, int count) const noexcept {
+    GetValuesImpl(context, x, y, z, out, count);
+}
+
+void Terrace::GetValues(const EvalContext& context, const float* x, const float* y, const float* z,
+    float* out, int count) const noexcept {
+    GetValuesImpl(context, x, y, z, out, count);
+}
 
+double Terrace::MapSourceValue(double sourceModuleValue) const noexcept {
     // Find the first element in the control point array that has a value
     // larger than the output value from the source module.
-    int indexPos;
-    for (indexPos = 0; indexPos < static_cast<int>(m_controlPoints.size()); indexPos++) {
-        if (sourceModuleValue < m_controlPoints[indexPos]) {
-            break;
-        }
-    }
+    const int indexPos = FindUpperControlPoint(m_controlPoints.data(),
+        static_cast<int>(m_controlPoints.size()), sourceModuleValue);
 
     // Find the two nearest control points so that we can map their values
     // onto a quadratic curve.
@@ -87,15 +145,11 @@ double Terrace::GetValue(double x, double y, double z) const noexcept {
 }
 
 int Terrace::FindInsertionPos(double value) const {
-    int insertionPos;
-    for (insertionPos = 0; insertionPos < static_cast<int>(m_controlPoints.size()); insertionPos++) {
-        if (value < m_controlPoints[insertionPos]) {
-            break;
-        } else if (value == m_controlPoints[insertionPos]) {
-            throw noise::ExceptionInvalidParam();
-        }
+    const auto pos = std::lower_bound(m_controlPoints.begin(), m_controlPoints.end(), value);
+    if (pos != m_controlPoints.end() && *pos == value) {
+        throw noise::ExceptionInvalidParam();
     }
-    return insertionPos;
+    return static_cast<int>(pos - m_controlPoints.begin());
 }
 
 void Terrace::InsertAtPos(int insertionPos, double value) {
@@ -115,4 +169,18 @@ void Terrace::MakeControlPoints(int controlPointCount) {
         AddControlPoint(curValue);
         curValue += terraceStep;
     }
-}
\ No newline at end of file
+}
+
+ValueRange Terrace::GetValueRange() const {
+    if (m_controlPoints.size() < 2) {
+        return ValueRange::Unbounded();
+    }
+
+    // The terrace-forming curve never decreases, so the bounds of the source
+    // range map onto the bounds of the output range. They are widened slightly
+    // to cover rounding in the interpolation.
+    const ValueRange source = GetSourceModule(0).GetValueRange();
+    const double lower = MapSourceValue(source.lowerBound);
+    const double upper = MapSourceValue(source.upperBound);
+    return { lower - 1.0e-12 * (1.0 + std::fabs(lower)), upper + 1.0e-12 * (1.0 + std::fabs(upper)) };
+}
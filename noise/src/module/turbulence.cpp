@@ -23,8 +23,179 @@
 
 #include "noise/module/turbulence.h"
 
+#include <vector>
+
 using namespace noise::module;
 
+namespace {
+
+    // Offsets from the input value at which the x, y and z distortion modules
+    // are sampled.
+    constexpr double DISTORT_OFFSETS[3][3] = {
+        { 12414.0 / 65536.0, 65124.0 / 65536.0, 31337.0 / 65536.0 },
+        { 26519.0 / 65536.0, 18128.0 / 65536.0, 60493.0 / 65536.0 },
+        { 53820.0 / 65536.0, 11213.0 / 65536.0, 44845.0 / 65536.0 }
+    };
+
+    // Number of input values per distortion module that GetValues() passes
+    // through the octave loop at a time.
+    constexpr int BATCH_BLOCK_SIZE = 16;
+
+}
+
+// The three distortion modules share every parameter except the seed: the y
+// and z modules use the seed of the x module plus one and plus two. Octave o
+// of module c therefore uses the seed of the x module plus c + o, and one
+// batch call per seed evaluates every octave that uses that seed. At step s,
+// module c evaluates octave s - c, so the loop runs for two more steps than
+// there are octaves.
+
+template <noise::NoiseQuality Q, typename Real>
+void Turbulence::CalcDistortedValues(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+    Real* xDistort, Real* yDistort, Real* zDistort, int count) const noexcept {
+    // Lane c * blockCount + i holds input value i of distortion module c, so the
+    // lanes of consecutive modules form one contiguous batch.
+    Real px[3 * BATCH_BLOCK_SIZE], py[3 * BATCH_BLOCK_SIZE], pz[3 * BATCH_BLOCK_SIZE];
+    Real nx[3 * BATCH_BLOCK_SIZE], ny[3 * BATCH_BLOCK_SIZE], nz[3 * BATCH_BLOCK_SIZE];
+    Real signal[3 * BATCH_BLOCK_SIZE], value[3 * BATCH_BLOCK_SIZE];
+    const Real frequency = static_cast<Real>(m_xDistortModule.GetFrequency());
+    const Real lacunarity = static_cast<Real>(m_xDistortModule.GetLacunarity());
+    const Real persistence = static_cast<Real>(m_xDistortModule.GetPersistence());
+    const Real power = static_cast<Real>(m_power);
+
+    // Octaves that the samples cannot resolve are faded out and skipped.
+    double octaveWeights[PERLIN_MAX_OCTAVE];
+    const int octaveCount = context.GetOctaveWeights(m_xDistortModule.GetFrequency(),
+        m_xDistortModule.GetLacunarity(), m_xDistortModule.GetEvaluatedOctaveCount(), octaveWeights);
+    if (context.stats != nullptr) {
+        context.stats->octaveCount += 3 * static_cast<std::uint64_t>(count) * static_cast<std::uint64_t>(octaveCount);
+    }
+
+    for (int start = 0; start < count; start += BATCH_BLOCK_SIZE) {
+        const int blockCount = std::min(BATCH_BLOCK_SIZE, count - start);
+        bool isPlanar[3];
+        for (int c = 0; c < 3; ++c) {
+            const Real xOffset = static_cast<Real>(DISTORT_OFFSETS[c][0]);
+            const Real yOffset = static_cast<Real>(DISTORT_OFFSETS[c][1]);
+            const Real zOffset = static_cast<Real>(DISTORT_OFFSETS[c][2]);
+            Real* cx = px + c * blockCount;
+            Real* cy = py + c * blockCount;
+            Real* cz = pz + c * blockCount;
+            isPlanar[c] = true;
+            for (int i = 0; i < blockCount; ++i) {
+                cx[i] = (x[start + i] + xOffset) * frequency;
+                cy[i] = (y[start + i] + yOffset) * frequency;
+                cz[i] = (z[start + i] + zOffset) * frequency;
+                isPlanar[c] = isPlanar[c] && (cy[i] == Real(0.0));
+                value[c * blockCount + i] = Real(0.0);
+            }
+        }
+
+        Real curPersistence[3] = { Real(1.0), Real(1.0), Real(1.0) };
+        for (int step = 0; step < octaveCount + 2; ++step) {
+            const int firstModule = std::max(0, step - octaveCount + 1);
+            const int lastModule = std::min(2, step);
+            const int firstLane = firstModule * blockCount;
+            const int endLane = (lastModule + 1) * blockCount;
+            for (int lane = firstLane; lane < endLane; ++lane) {
+                nx[lane] = static_cast<Real>(MakeInt32Range(px[lane]));
+                ny[lane] = static_cast<Real>(MakeInt32Range(py[lane]));
+                nz[lane] = static_cast<Real>(MakeInt32Range(pz[lane]));
+            }
+
+            // As in the Perlin noise module, a block on the plane y = 0 uses the
+            // two-dimensional noise function; consecutive modules that do not
+            // share one batch call.
+            int32 seed = (m_xDistortModule.GetSeed() + step) & 0xffffffff;
+            for (int c = firstModule; c <= lastModule;) {
+                const int lane = c * blockCount;
+                if (isPlanar[c]) {
+                    GradientCoherentNoise2D<Q>(nx + lane, nz + lane, signal + lane, blockCount, seed);
+                    ++c;
+                    continue;
+                }
+                int last = c;
+                while (last < lastModule && !isPlanar[last + 1]) {
+                    ++last;
+                }
+                GradientCoherentNoise3D<Q>(nx + lane, ny + lane, nz + lane, signal + lane,
+                    (last - c + 1) * blockCount, seed);
+                c = last + 1;
+            }
+
+            for (int c = firstModule; c <= lastModule; ++c) {
+                const int curOctave = step - c;
+                const Real octavePersistence = curPersistence[c] * static_cast<Real>(octaveWeights[curOctave]);
+                for (int lane = c * blockCount; lane < (c + 1) * blockCount; ++lane) {
+                    value[lane] += signal[lane] * octavePersistence;
+                    px[lane] *= lacunarity;
+                    py[lane] *= lacunarity;
+                    pz[lane] *= lacunarity;
+                }
+                curPersistence[c] *= persistence;
+            }
+        }
+
+        for (int i = 0; i < blockCount; ++i) {
+            xDistort[start + i] = x[start + i] + (value[i] * power);
+            yDistort[start + i] = y[start + i] + (value[blockCount + i] * power);
+            zDistort[start + i] = z[start + i] + (value[2 * blockCount + i] * power);
+        }
+    }
+}
+
+template <typename Real>
+void Turbulence::GetDistortedValues(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+    Real* xDistort, Real* yDistort, Real* zDistort, int count) const noexcept {
+    switch (m_xDistortModule.GetNoiseQuality()) {
+        case NoiseQuality::QUALITY_FAST:
+            CalcDistortedValues<NoiseQuality::QUALITY_FAST>(context, x, y, z, xDistort, yDistort, zDistort, count);
+            break;
+        case NoiseQuality::QUALITY_STD:
+            CalcDistortedValues<NoiseQuality::QUALITY_STD>(context, x, y, z, xDistort, yDistort, zDistort, count);
+            break;
+        case NoiseQuality::QUALITY_BEST:
+        default:
+            CalcDistortedValues<NoiseQuality::QUALITY_BEST>(context, x, y, z, xDistort, yDistort, zDistort, count);
+            break;
+    }
+}
+
+// CompiledGraph displaces its coordinate registers with the double-precision overload.
+template void Turbulence::GetDistortedValues<double>(const EvalContext&, const double*, const double*,
+    const double*, double*, double*, double*, int) const noexcept;
+
+template <typename Real>
+void Turbulence::GetValuesImpl(const EvalContext& context, const Real* x, const Real* y, const Real* z,
+    Real* out, int count) const noexcept {
+    assert(m_sourceModules[0] != nullptr && "Source module must be set before calling GetValues");
+
+    const size_t size = static_cast<size_t>(count);
+    std::vector<Real> xDistort(size), yDistort(size), zDistort(size);
+    GetDistortedValues(context, x, y, z, xDistort.data(), yDistort.data(), zDistort.data(), count);
+    m_sourceModules[0]->GetValues(context, xDistort.data(), yDistort.data(), zDistort.data(), out, count);
+}
+
+void Turbulence::GetValues(const double* x, const double* y, const double* z,
+    double* out, int count) const noexcept {
+    GetValuesImpl(EvalContext(), x, y, z, out, count);
+}
+
+void Turbulence::GetValues(const float* x, const float* y, const float* z,
+    float* out, int count) const noexcept {
+    GetValuesImpl(EvalContext(), x, y, z, out, count);
+}
+
+void Turbulence::GetValues(const EvalContext& context, const double* x, const double* y, const double* z,
+    double* out, int count) const noexcept {
+    GetValuesImpl(context, x, y, z, out, count);
+}
+
+void Turbulence::GetValues(const EvalContext& context, const float* x, const float* y, const float* z,
+    float* out, int count) const noexcept {
+    GetValuesImpl(context, x, y, z, out, count);
+}
+
 void Turbulence::SetSeed(int seed) noexcept {
     m_xDistortModule.SetSeed(seed);
     m_yDistortModule.SetSeed(seed + 1);
@@ -22,48 +22,288 @@
 // - Moved constructor to header as inline.
 // - Added include for mathconsts.h (../mathconsts.h) for SQRT_3.
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include "noise/mathconsts.h"
 #include "noise/module/voronoi.h"
+#include "../simd.h"
 
 using namespace noise::module;
 
-double Voronoi::GetValue(double x, double y, double z) const noexcept {
-    x *= m_frequency;
-    y *= m_frequency;
-    z *= m_frequency;
+namespace {
 
-    int xInt = (x > 0.0 ? static_cast<int>(x) : static_cast<int>(x) - 1);
-    int yInt = (y > 0.0 ? static_cast<int>(y) : static_cast<int>(y) - 1);
-    int zInt = (z > 0.0 ? static_cast<int>(z) : static_cast<int>(z) - 1);
+    // Number of cells searched along each axis, centered on the cell that
+    // contains the input value.
+    constexpr int SEARCH_WIDTH = 5;
 
-    double minDist = std::numeric_limits<double>::max();
-    double xCandidate = 0.0;
-    double yCandidate = 0.0;
-    double zCandidate = 0.0;
+    // Number of cells searched for the nearest seed point.
+    constexpr int SEARCH_CELL_COUNT = SEARCH_WIDTH * SEARCH_WIDTH * SEARCH_WIDTH;
+
+    // Index of the center cell within the searched block.
+    constexpr int SEARCH_CENTER_INDEX = SEARCH_CELL_COUNT / 2;
+
+    // Returns the seed point of a cell.
+    inline void GetSeedPoint(int xCur, int yCur, int zCur, int seed,
+        double& xPos, double& yPos, double& zPos) noexcept {
+        xPos = xCur + noise::ValueNoise3D(xCur, yCur, zCur, seed);
+        yPos = yCur + noise::ValueNoise3D(xCur, yCur, zCur, seed + 1);
+        zPos = zCur + noise::ValueNoise3D(xCur, yCur, zCur, seed + 2);
+    }
+
+    // Returns a lower bound on the squared distance along one axis from the
+    // coordinate p to the seed point of cell c. ValueNoise3D() returns values
+    // in (-1.0, 3.0] (see Voronoi::GetValueRange()), so the seed point lies in
+    // (c - 1, c + 3]. Rounding is monotonic, so the bound never exceeds the
+    // squared distance as the search computes it.
+    inline double GetAxisGap(double p, int c) noexcept {
+        const double below = static_cast<double>(c - 1) - p;
+        const double above = p - static_cast<double>(c + 3);
+        if (below > 0.0) {
+            return below * below;
+        }
+        return above > 0.0 ? above * above : 0.0;
+    }
+
+    // Seed points of the block of cells around one cell, in search order.
+    struct SeedBlock {
+        int xInt = 0;
+        int yInt = 0;
+        int zInt = 0;
+        bool isValid = false;
+        double x[SEARCH_CELL_COUNT];
+        double y[SEARCH_CELL_COUNT];
+        double z[SEARCH_CELL_COUNT];
+    };
+
+    // Fills the seed points of the block around a cell, copying the seed points
+    // of the cells that the previous block shares with it.
+    void FillSeedBlock(SeedBlock& block, const SeedBlock& previous,
+        int xInt, int yInt, int zInt, int seed) noexcept {
+        constexpr int radius = SEARCH_WIDTH / 2;
+        int index = 0;
+        for (int zCur = zInt - radius; zCur <= zInt + radius; zCur++) {
+            for (int yCur = yInt - radius; yCur <= yInt + radius; yCur++) {
+                for (int xCur = xInt - radius; xCur <= xInt + radius; xCur++, index++) {
+                    const int xOld = xCur - previous.xInt + radius;
+                    const int yOld = yCur - previous.yInt + radius;
+                    const int zOld = zCur - previous.zInt + radius;
+                    if (previous.isValid && xOld >= 0 && xOld < SEARCH_WIDTH && yOld >= 0
+                        && yOld < SEARCH_WIDTH && zOld >= 0 && zOld < SEARCH_WIDTH) {
+                        const int oldIndex = (zOld * SEARCH_WIDTH + yOld) * SEARCH_WIDTH + xOld;
+                        block.x[index] = previous.x[oldIndex];
+                        block.y[index] = previous.y[oldIndex];
+                        block.z[index] = previous.z[oldIndex];
+                    } else {
+                        GetSeedPoint(xCur, yCur, zCur, seed, block.x[index], block.y[index], block.z[index]);
+                    }
+                }
+            }
+        }
+        block.xInt = xInt;
+        block.yInt = yInt;
+        block.zInt = zInt;
+        block.isValid = true;
+    }
+
+    // Finds the first seed point, in search order, that is nearest to the input
+    // value (x, y, z) in cell (xInt, yInt, zInt), and returns the index of its
+    // cell in the searched block. getSeedPoint(index, xCur, yCur, zCur, xPos,
+    // yPos, zPos) returns the seed point of a cell.
+    //
+    // The seed point of the center cell bounds the nearest distance, so a slab,
+    // row or cell whose lower bound (see GetAxisGap()) exceeds that distance is
+    // skipped: it cannot hold a seed point at the nearest distance, and the
+    // first seed point at the nearest distance is still found.
+    template <typename SeedPointFunc>
+    int FindNearestSeedPoint(double x, double y, double z, int xInt, int yInt, int zInt,
+        SeedPointFunc getSeedPoint, double& xCandidate, double& yCandidate, double& zCandidate) noexcept {
+        constexpr int radius = SEARCH_WIDTH / 2;
+        double xGap[SEARCH_WIDTH], yGap[SEARCH_WIDTH], zGap[SEARCH_WIDTH];
+        for (int i = 0; i < SEARCH_WIDTH; ++i) {
+            xGap[i] = GetAxisGap(x, xInt - radius + i);
+            yGap[i] = GetAxisGap(y, yInt - radius + i);
+            zGap[i] = GetAxisGap(z, zInt - radius + i);
+        }
+
+        double xCenter, yCenter, zCenter;
+        getSeedPoint(SEARCH_CENTER_INDEX, xInt, yInt, zInt, xCenter, yCenter, zCenter);
+        double xDist = xCenter - x;
+        double yDist = yCenter - y;
+        double zDist = zCenter - z;
+        double bound = xDist * xDist + yDist * yDist + zDist * zDist;
+
+        double minDist = std::numeric_limits<double>::max();
+        int nearest = 0;
+        for (int k = 0; k < SEARCH_WIDTH; ++k) {
+            if (zGap[k] > bound) {
+                continue;
+            }
+            for (int j = 0; j < SEARCH_WIDTH; ++j) {
+                if (yGap[j] + zGap[k] > bound) {
+                    continue;
+                }
+                for (int i = 0; i < SEARCH_WIDTH; ++i) {
+                    if (xGap[i] + yGap[j] + zGap[k] > bound) {
+                        continue;
+                    }
+                    const int index = (k * SEARCH_WIDTH + j) * SEARCH_WIDTH + i;
+                    double xPos, yPos, zPos;
+                    getSeedPoint(index, xInt - radius + i, yInt - radius + j, zInt - radius + k, xPos, yPos, zPos);
+                    xDist = xPos - x;
+                    yDist = yPos - y;
+                    zDist = zPos - z;
+                    const double dist = xDist * xDist + yDist * yDist + zDist * zDist;
 
-    // Search nearby cubes for the closest seed point.
-    for (int zCur = zInt - 2; zCur <= zInt + 2; zCur++) {
-        for (int yCur = yInt - 2; yCur <= yInt + 2; yCur++) {
-            for (int xCur = xInt - 2; xCur <= xInt + 2; xCur++) {
-                double xPos = xCur + ValueNoise3D(xCur, yCur, zCur, m_seed);
-                double yPos = yCur + ValueNoise3D(xCur, yCur, zCur, m_seed + 1);
-                double zPos = zCur + ValueNoise3D(xCur, yCur, zCur, m_seed + 2);
-                double xDist = xPos - x;
-                double yDist = yPos - y;
-                double zDist = zPos - z;
-                double dist = xDist * xDist + yDist * yDist + zDist * zDist;
-
-                if (dist < minDist) {
-                    minDist = dist;
-                    xCandidate = xPos;
-                    yCandidate = yPos;
-                    zCandidate = zPos;
+                    if (dist < minDist) {
+                        minDist = dist;
+                        bound = std::min(bound, dist);
+                        nearest = index;
+                        xCandidate = xPos;
+                        yCandidate = yPos;
+                        zCandidate = zPos;
+                    }
                 }
             }
         }
+        return nearest;
+    }
+
+    // Returns the integer coordinate of the cell that contains a coordinate.
+    inline int GetCell(double p) noexcept {
+        return (p > 0.0 ? static_cast<int>(p) : static_cast<int>(p) - 1);
+    }
+
+    // Number of input values that GetValues() scales and assigns to cells at a time.
+    constexpr int BATCH_BLOCK_SIZE = 64;
+
+    // Signature shared by the scalar and SIMD kernels that find the nearest seed
+    // points of a run of input values in the center cell of a block. Each kernel
+    // writes the index in the block of the first nearest seed point in search
+    // order, as FindNearestSeedPoint() does.
+    using NearestSeedKernel = void (*)(const SeedBlock& block, const double* x,
+        const double* y, const double* z, int* nearest, int count);
+
+    // Reference kernel; searches for each input value with FindNearestSeedPoint().
+    void FindNearestSeedPointsScalar(const SeedBlock& block, const double* x,
+        const double* y, const double* z, int* nearest, int count) noexcept {
+        for (int i = 0; i < count; ++i) {
+            double xCandidate, yCandidate, zCandidate;
+            nearest[i] = FindNearestSeedPoint(x[i], y[i], z[i], block.xInt, block.yInt, block.zInt,
+                [&](int index, int, int, int, double& xPos, double& yPos, double& zPos) {
+                    xPos = block.x[index];
+                    yPos = block.y[index];
+                    zPos = block.z[index];
+                },
+                xCandidate, yCandidate, zCandidate);
+        }
+    }
+
+#ifdef NOISE_SIMD_X86
+
+    // The SIMD kernels compare every cell of the block with several input
+    // values at once instead of skipping the cells that FindNearestSeedPoint()
+    // rules out. They compute each squared distance with the same operations,
+    // in the same order, and keep the first nearest cell, so they find the same
+    // cell; they must not be compiled with FMA contraction.
+
+    NOISE_TARGET_SSE41 void FindNearestSeedPointsSse41(const SeedBlock& block, const double* x,
+        const double* y, const double* z, int* nearest, int count) noexcept {
+        int i = 0;
+        for (; i + 2 <= count; i += 2) {
+            const __m128d px = _mm_loadu_pd(x + i);
+            const __m128d py = _mm_loadu_pd(y + i);
+            const __m128d pz = _mm_loadu_pd(z + i);
+            __m128d minDist = _mm_set1_pd(std::numeric_limits<double>::max());
+            __m128d minIndex = _mm_setzero_pd();
+            for (int index = 0; index < SEARCH_CELL_COUNT; ++index) {
+                const __m128d xDist = _mm_sub_pd(_mm_set1_pd(block.x[index]), px);
+                const __m128d yDist = _mm_sub_pd(_mm_set1_pd(block.y[index]), py);
+                const __m128d zDist = _mm_sub_pd(_mm_set1_pd(block.z[index]), pz);
+                const __m128d dist = _mm_add_pd(_mm_add_pd(_mm_mul_pd(xDist, xDist), _mm_mul_pd(yDist, yDist)),
+                    _mm_mul_pd(zDist, zDist));
+                const __m128d closer = _mm_cmplt_pd(dist, minDist);
+                minDist = _mm_blendv_pd(minDist, dist, closer);
+                minIndex = _mm_blendv_pd(minIndex, _mm_set1_pd(index), closer);
+            }
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(nearest + i), _mm_cvttpd_epi32(minIndex));
+        }
+        FindNearestSeedPointsScalar(block, x + i, y + i, z + i, nearest + i, count - i);
+    }
+
+    NOISE_TARGET_AVX2 inline void CompareSeedPointAvx2(__m256d xPos, __m256d yPos, __m256d zPos,
+        __m256d index, __m256d px, __m256d py, __m256d pz, __m256d& minDist, __m256d& minIndex) noexcept {
+        const __m256d xDist = _mm256_sub_pd(xPos, px);
+        const __m256d yDist = _mm256_sub_pd(yPos, py);
+        const __m256d zDist = _mm256_sub_pd(zPos, pz);
+        const __m256d dist = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(xDist, xDist),
+            _mm256_mul_pd(yDist, yDist)), _mm256_mul_pd(zDist, zDist));
+        const __m256d closer = _mm256_cmp_pd(dist, minDist, _CMP_LT_OQ);
+        minDist = _mm256_blendv_pd(minDist, dist, closer);
+        minIndex = _mm256_blendv_pd(minIndex, index, closer);
     }
 
+    NOISE_TARGET_AVX2 void FindNearestSeedPointsAvx2(const SeedBlock& block, const double* x,
+        const double* y, const double* z, int* nearest, int count) noexcept {
+        // Two groups of four input values are searched together, so that the
+        // comparisons of one group hide the latency of the other.
+        int i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m256d px0 = _mm256_loadu_pd(x + i);
+            const __m256d py0 = _mm256_loadu_pd(y + i);
+            const __m256d pz0 = _mm256_loadu_pd(z + i);
+            const __m256d px1 = _mm256_loadu_pd(x + i + 4);
+            const __m256d py1 = _mm256_loadu_pd(y + i + 4);
+            const __m256d pz1 = _mm256_loadu_pd(z + i + 4);
+            __m256d minDist0 = _mm256_set1_pd(std::numeric_limits<double>::max());
+            __m256d minDist1 = minDist0;
+            __m256d minIndex0 = _mm256_setzero_pd();
+            __m256d minIndex1 = minIndex0;
+            for (int index = 0; index < SEARCH_CELL_COUNT; ++index) {
+                const __m256d xPos = _mm256_set1_pd(block.x[index]);
+                const __m256d yPos = _mm256_set1_pd(block.y[index]);
+                const __m256d zPos = _mm256_set1_pd(block.z[index]);
+                const __m256d cell = _mm256_set1_pd(index);
+                CompareSeedPointAvx2(xPos, yPos, zPos, cell, px0, py0, pz0, minDist0, minIndex0);
+                CompareSeedPointAvx2(xPos, yPos, zPos, cell, px1, py1, pz1, minDist1, minIndex1);
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(nearest + i), _mm256_cvttpd_epi32(minIndex0));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(nearest + i + 4), _mm256_cvttpd_epi32(minIndex1));
+        }
+        for (; i + 4 <= count; i += 4) {
+            const __m256d px = _mm256_loadu_pd(x + i);
+            const __m256d py = _mm256_loadu_pd(y + i);
+            const __m256d pz = _mm256_loadu_pd(z + i);
+            __m256d minDist = _mm256_set1_pd(std::numeric_limits<double>::max());
+            __m256d minIndex = _mm256_setzero_pd();
+            for (int index = 0; index < SEARCH_CELL_COUNT; ++index) {
+                CompareSeedPointAvx2(_mm256_set1_pd(block.x[index]), _mm256_set1_pd(block.y[index]),
+                    _mm256_set1_pd(block.z[index]), _mm256_set1_pd(index), px, py, pz, minDist, minIndex);
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(nearest + i), _mm256_cvttpd_epi32(minIndex));
+        }
+        FindNearestSeedPointsScalar(block, x + i, y + i, z + i, nearest + i, count - i);
+    }
+
+#endif // NOISE_SIMD_X86
+
+    // Selects the fastest nearest-seed kernel that the processor supports.
+    NearestSeedKernel SelectNearestSeedKernel() noexcept {
+#ifdef NOISE_SIMD_X86
+        if (noise::simd::CpuSupportsAvx2()) {
+            return FindNearestSeedPointsAvx2;
+        }
+        if (noise::simd::CpuSupportsSse41()) {
+            return FindNearestSeedPointsSse41;
+        }
+#endif
+        return FindNearestSeedPointsScalar;
+    }
+
+}
+
+double Voronoi::CalcValue(double x, double y, double z,
+    double xCandidate, double yCandidate, double zCandidate) const noexcept {
     double value;
     if (m_enableDistance) {
         double xDist = xCandidate - x;
@@ -79,4 +319,117 @@ double Voronoi::GetValue(double x, double y, double z) const noexcept {
         static_cast<int>(std::floor(xCandidate)),
         static_cast<int>(std::floor(yCandidate)),
         static_cast<int>(std::floor(zCandidate))));
-}
\ No newline at end of file
+}
+
+double Voronoi::GetValue(double x, double y, double z) const noexcept {
+    x *= m_frequency;
+    y *= m_frequency;
+    z *= m_frequency;
+
+    const int xInt = GetCell(x);
+    const int yInt = GetCell(y);
+    const int zInt = GetCell(z);
+
+    // Search nearby cubes for the closest seed point. The seed point of the
+    // center cell is computed first and reused when the search reaches it.
+    bool hasCenter = false;
+    double xCenter = 0.0, yCenter = 0.0, zCenter = 0.0;
+    double xCandidate = 0.0;
+    double yCandidate = 0.0;
+    double zCandidate = 0.0;
+    FindNearestSeedPoint(x, y, z, xInt, yInt, zInt,
+        [&](int index, int xCur, int yCur, int zCur, double& xPos, double& yPos, double& zPos) {
+            if (index == SEARCH_CENTER_INDEX && hasCenter) {
+                xPos = xCenter;
+                yPos = yCenter;
+                zPos = zCenter;
+                return;
+            }
+            GetSeedPoint(xCur, yCur, zCur, m_seed, xPos, yPos, zPos);
+            if (index == SEARCH_CENTER_INDEX) {
+                xCenter = xPos;
+                yCenter = yPos;
+                zCenter = zPos;
+                hasCenter = true;
+            }
+        },
+        xCandidate, yCandidate, zCandidate);
+
+    return CalcValue(x, y, z, xCandidate, yCandidate, zCandidate);
+}
+
+template <typename Real>
+void Voronoi::GetValuesImpl(const Real* x, const Real* y, const Real* z,
+    Real* out, int count) const noexcept {
+    static const NearestSeedKernel findNearestSeedPoints = SelectNearestSeedKernel();
+
+    // Neighboring input values usually lie in the same or an adjacent cell, so
+    // the seed points of the searched block are kept from one input value to
+    // the next, and only the cells that enter the block are computed. Each run
+    // of input values in the same cell is searched by one kernel call.
+    SeedBlock blocks[2];
+    int current = 0;
+    double xScaled[BATCH_BLOCK_SIZE], yScaled[BATCH_BLOCK_SIZE], zScaled[BATCH_BLOCK_SIZE];
+    int xInt[BATCH_BLOCK_SIZE], yInt[BATCH_BLOCK_SIZE], zInt[BATCH_BLOCK_SIZE];
+    int nearest[BATCH_BLOCK_SIZE];
+    for (int start = 0; start < count; start += BATCH_BLOCK_SIZE) {
+        const int blockCount = std::min(BATCH_BLOCK_SIZE, count - start);
+        for (int i = 0; i < blockCount; ++i) {
+            xScaled[i] = static_cast<double>(x[start + i]) * m_frequency;
+            yScaled[i] = static_cast<double>(y[start + i]) * m_frequency;
+            zScaled[i] = static_cast<double>(z[start + i]) * m_frequency;
+            xInt[i] = GetCell(xScaled[i]);
+            yInt[i] = GetCell(yScaled[i]);
+            zInt[i] = GetCell(zScaled[i]);
+        }
+
+        int runStart = 0;
+        while (runStart < blockCount) {
+            int runEnd = runStart + 1;
+            while (runEnd < blockCount && xInt[runEnd] == xInt[runStart]
+                && yInt[runEnd] == yInt[runStart] && zInt[runEnd] == zInt[runStart]) {
+                ++runEnd;
+            }
+
+            if (!blocks[current].isValid || blocks[current].xInt != xInt[runStart]
+                || blocks[current].yInt != yInt[runStart] || blocks[current].zInt != zInt[runStart]) {
+                FillSeedBlock(blocks[1 - current], blocks[current],
+                    xInt[runStart], yInt[runStart], zInt[runStart], m_seed);
+                current = 1 - current;
+            }
+            const SeedBlock& block = blocks[current];
+
+            findNearestSeedPoints(block, xScaled + runStart, yScaled + runStart, zScaled + runStart,
+                nearest + runStart, runEnd - runStart);
+            for (int i = runStart; i < runEnd; ++i) {
+                const int index = nearest[i];
+                out[start + i] = static_cast<Real>(CalcValue(xScaled[i], yScaled[i], zScaled[i],
+                    block.x[index], block.y[index], block.z[index]));
+            }
+            runStart = runEnd;
+        }
+    }
+}
+
+void Voronoi::GetValues(const double* x, const double* y, const double* z,
+    double* out, int count) const noexcept {
+    GetValuesImpl(x, y, z, out, count);
+}
+
+void Voronoi::GetValues(const float* x, const float* y, const float* z,
+    float* out, int count) const noexcept {
+    GetValuesImpl(x, y, z, out, count);
+}
+
+ValueRange Voronoi::GetValueRange() const {
+    // ValueNoise3D() is meant to return -1.0 to +1.0, but IntValueNoise3D()
+    // relies on signed overflow, and an optimizing compiler may drop its final
+    // mask, which extends the range of ValueNoise3D() up to +3.0. Then each seed
+    // point lies within 3.0 of the unit cube that it belongs to along each axis,
+    // so the nearest seed point is at most 3 * sqrt(3) away from the input value.
+    const ValueRange valueNoise = { -1.0, 3.0 };
+    const ValueRange distance = m_enableDistance
+        ? ValueRange{ -1.0, (3.0 * SQRT_3) * SQRT_3 - 1.0 } : ValueRange{ 0.0, 0.0 };
+    const ValueRange displacement = valueNoise.Product({ m_displacement, m_displacement });
+    return { distance.lowerBound + displacement.lowerBound, distance.upperBound + displacement.upperBound };
+}
@@ -27,6 +27,9 @@
 #include <noise/noisegen.h>
 #include <noise/interp.h>
 #include <noise/vectortable.h>
+#include "simd.h"
+
+#include <array>
 
 namespace noise {
 
@@ -62,10 +65,35 @@ namespace noise {
             return static_cast<int32>(std::floor(x));
         }
 
+        // Maps a value onto the S-curve that the noise quality Q uses.
+        template <NoiseQuality Q, typename Real>
+        inline Real SCurve(Real a) noexcept {
+            if constexpr (Q == NoiseQuality::QUALITY_FAST) {
+                return a;
+            } else if constexpr (Q == NoiseQuality::QUALITY_STD) {
+                return SCurve3(a);
+            } else {
+                return SCurve5(a);
+            }
+        }
+
+        // Returns the derivative of SCurve<Q>() at @a a.
+        template <NoiseQuality Q>
+        inline double SCurveDerivative(double a) noexcept {
+            if constexpr (Q == NoiseQuality::QUALITY_FAST) {
+                return 1.0;
+            } else if constexpr (Q == NoiseQuality::QUALITY_STD) {
+                return 6.0 * a * (1.0 - a);
+            } else {
+                const double b = a * (a - 1.0);
+                return 30.0 * b * b;
+            }
+        }
+
     }
 
-    double GradientCoherentNoise3D(double x, double y, double z, int32 seed,
-        NoiseQuality noiseQuality) noexcept {
+    template <NoiseQuality Q>
+    double GradientCoherentNoise3D(double x, double y, double z, int32 seed) noexcept {
         // Create a unit-length cube aligned along an integer boundary. This cube surrounds the input point.
         const int32 x0 = FastFloor(x);
         const int32 x1 = x0 + 1;
@@ -76,24 +104,9 @@ namespace noise {
 
         // Map the difference between the coordinates of the input value and the
         // coordinates of the cube's outer-lower-left vertex onto an S-curve.
-        double xs = 0, ys = 0, zs = 0;
-        switch (noiseQuality) {
-            case NoiseQuality::QUALITY_FAST:
-                xs = (x - static_cast<double>(x0));
-                ys = (y - static_cast<double>(y0));
-                zs = (z - static_cast<double>(z0));
-                break;
-            case NoiseQuality::QUALITY_STD:
-                xs = SCurve3(x - static_cast<double>(x0));
-                ys = SCurve3(y - static_cast<double>(y0));
-                zs = SCurve3(z - static_cast<double>(z0));
-                break;
-            case NoiseQuality::QUALITY_BEST:
-                xs = SCurve5(x - static_cast<double>(x0));
-                ys = SCurve5(y - static_cast<double>(y0));
-                zs = SCurve5(z - static_cast<double>(z0));
-                break;
-        }
+        const double xs = SCurve<Q>(x - static_cast<double>(x0));
+        const double ys = SCurve<Q>(y - static_cast<double>(y0));
+        const double zs = SCurve<Q>(z - static_cast<double>(z0));
 
         // Now calculate the noise values at each vertex of the cube. Interpolate these eight
         // noise values using the S-curve value as the interpolant (trilinear interpolation).
@@ -115,6 +128,62 @@ namespace noise {
         return LinearInterp(iy0, iy1, zs);
     }
 
+    template double GradientCoherentNoise3D<NoiseQuality::QUALITY_FAST>(double, double, double, int32) noexcept;
+    template double GradientCoherentNoise3D<NoiseQuality::QUALITY_STD>(double, double, double, int32) noexcept;
+    template double GradientCoherentNoise3D<NoiseQuality::QUALITY_BEST>(double, double, double, int32) noexcept;
+
+    double GradientCoherentNoise3D(double x, double y, double z, int32 seed,
+        NoiseQuality noiseQuality) noexcept {
+        switch (noiseQuality) {
+            case NoiseQuality::QUALITY_FAST:
+                return GradientCoherentNoise3D<NoiseQuality::QUALITY_FAST>(x, y, z, seed);
+            case NoiseQuality::QUALITY_STD:
+                return GradientCoherentNoise3D<NoiseQuality::QUALITY_STD>(x, y, z, seed);
+            case NoiseQuality::QUALITY_BEST:
+            default:
+                return GradientCoherentNoise3D<NoiseQuality::QUALITY_BEST>(x, y, z, seed);
+        }
+    }
+
+    template <NoiseQuality Q>
+    double GradientCoherentNoise2D(double x, double z, int32 seed) noexcept {
+        // The input value lies on the lower face of its cube, so the S-curve value
+        // along the y axis is zero and the vertices of the upper face do not
+        // contribute. Only the four vertices of the lower face are evaluated.
+        const int32 x0 = FastFloor(x);
+        const int32 x1 = x0 + 1;
+        const int32 z0 = FastFloor(z);
+        const int32 z1 = z0 + 1;
+
+        const double xs = SCurve<Q>(x - static_cast<double>(x0));
+        const double zs = SCurve<Q>(z - static_cast<double>(z0));
+
+        double n0 = GradientNoise3D(x, 0.0, z, x0, 0, z0, seed);
+        double n1 = GradientNoise3D(x, 0.0, z, x1, 0, z0, seed);
+        const double ix0 = LinearInterp(n0, n1, xs);
+        n0 = GradientNoise3D(x, 0.0, z, x0, 0, z1, seed);
+        n1 = GradientNoise3D(x, 0.0, z, x1, 0, z1, seed);
+        const double ix1 = LinearInterp(n0, n1, xs);
+
+        return LinearInterp(ix0, ix1, zs);
+    }
+
+    template double GradientCoherentNoise2D<NoiseQuality::QUALITY_FAST>(double, double, int32) noexcept;
+    template double GradientCoherentNoise2D<NoiseQuality::QUALITY_STD>(double, double, int32) noexcept;
+    template double GradientCoherentNoise2D<NoiseQuality::QUALITY_BEST>(double, double, int32) noexcept;
+
+    double GradientCoherentNoise2D(double x, double z, int32 seed, NoiseQuality noiseQuality) noexcept {
+        switch (noiseQuality) {
+            case NoiseQuality::QUALITY_FAST:
+                return GradientCoherentNoise2D<NoiseQuality::QUALITY_FAST>(x, z, seed);
+            case NoiseQuality::QUALITY_STD:
+                return GradientCoherentNoise2D<NoiseQuality::QUALITY_STD>(x, z, seed);
+            case NoiseQuality::QUALITY_BEST:
+            default:
+                return GradientCoherentNoise2D<NoiseQuality::QUALITY_BEST>(x, z, seed);
+        }
+    }
+
     double GradientNoise3D(double fx, double fy, double fz, int32 ix,
         int32 iy, int32 iz, int32 seed) noexcept {
         // Randomly generate a gradient vector given the integer coordinates of the
@@ -144,6 +213,1042 @@ namespace noise {
         return (xvGradient * xvPoint + yvGradient * yvPoint + zvGradient * zvPoint) * 2.12;
     }
 
+    namespace {
+
+        // A noise value and its partial derivatives with respect to x, y, and z.
+        struct NoiseSample {
+            double value;
+            double dx;
+            double dy;
+            double dz;
+        };
+
+        // GradientNoise3D() together with its partial derivatives, which are the
+        // components of the scaled gradient vector.
+        inline NoiseSample GradientNoiseSample(double fx, double fy, double fz,
+            int32 ix, int32 iy, int32 iz, int32 seed) noexcept {
+            uint32 vectorIndex = (
+                X_NOISE_GEN * static_cast<uint32>(ix) +
+                Y_NOISE_GEN * static_cast<uint32>(iy) +
+                Z_NOISE_GEN * static_cast<uint32>(iz) +
+                SEED_NOISE_GEN * static_cast<uint32>(seed)
+            );
+            vectorIndex = (vectorIndex ^ (vectorIndex >> SHIFT_NOISE_GEN)) & 0xff;
+
+            const double* gradient = g_randomVectors + vectorIndex * 4;
+            const double xvPoint = (fx - static_cast<double>(ix));
+            const double yvPoint = (fy - static_cast<double>(iy));
+            const double zvPoint = (fz - static_cast<double>(iz));
+            return {
+                (gradient[0] * xvPoint + gradient[1] * yvPoint + gradient[2] * zvPoint) * 2.12,
+                gradient[0] * 2.12, gradient[1] * 2.12, gradient[2] * 2.12
+            };
+        }
+
+        // Interpolates between two samples along one axis. @a s is the S-curve
+        // value along that axis and @a ds is its derivative; the product rule adds
+        // (n1 - n0) * ds to the partial derivative along the axis.
+        inline NoiseSample InterpSample(const NoiseSample& n0, const NoiseSample& n1,
+            double s, double ds, int axis) noexcept {
+            NoiseSample result{
+                LinearInterp(n0.value, n1.value, s),
+                LinearInterp(n0.dx, n1.dx, s),
+                LinearInterp(n0.dy, n1.dy, s),
+                LinearInterp(n0.dz, n1.dz, s)
+            };
+            const double slope = (n1.value - n0.value) * ds;
+            if (axis == 0) {
+                result.dx += slope;
+            } else if (axis == 1) {
+                result.dy += slope;
+            } else {
+                result.dz += slope;
+            }
+            return result;
+        }
+
+    }
+
+    template <NoiseQuality Q>
+    double GradientCoherentNoise3D(double x, double y, double z,
+        double& dx, double& dy, double& dz, int32 seed) noexcept {
+        // This follows GradientCoherentNoise3D(), carrying the partial derivatives
+        // through each interpolation step, so the value is identical.
+        const int32 x0 = FastFloor(x);
+        const int32 x1 = x0 + 1;
+        const int32 y0 = FastFloor(y);
+        const int32 y1 = y0 + 1;
+        const int32 z0 = FastFloor(z);
+        const int32 z1 = z0 + 1;
+
+        const double xs = SCurve<Q>(x - static_cast<double>(x0));
+        const double ys = SCurve<Q>(y - static_cast<double>(y0));
+        const double zs = SCurve<Q>(z - static_cast<double>(z0));
+        const double dxs = SCurveDerivative<Q>(x - static_cast<double>(x0));
+        const double dys = SCurveDerivative<Q>(y - static_cast<double>(y0));
+        const double dzs = SCurveDerivative<Q>(z - static_cast<double>(z0));
+
+        NoiseSample n0 = GradientNoiseSample(x, y, z, x0, y0, z0, seed);
+        NoiseSample n1 = GradientNoiseSample(x, y, z, x1, y0, z0, seed);
+        const NoiseSample ix0 = InterpSample(n0, n1, xs, dxs, 0);
+        n0 = GradientNoiseSample(x, y, z, x0, y1, z0, seed);
+        n1 = GradientNoiseSample(x, y, z, x1, y1, z0, seed);
+        const NoiseSample ix1 = InterpSample(n0, n1, xs, dxs, 0);
+        const NoiseSample iy0 = InterpSample(ix0, ix1, ys, dys, 1);
+        n0 = GradientNoiseSample(x, y, z, x0, y0, z1, seed);
+        n1 = GradientNoiseSample(x, y, z, x1, y0, z1, seed);
+        const NoiseSample ix2 = InterpSample(n0, n1, xs, dxs, 0);
+        n0 = GradientNoiseSample(x, y, z, x0, y1, z1, seed);
+        n1 = GradientNoiseSample(x, y, z, x1, y1, z1, seed);
+        const NoiseSample ix3 = InterpSample(n0, n1, xs, dxs, 0);
+        const NoiseSample iy1 = InterpSample(ix2, ix3, ys, dys, 1);
+        const NoiseSample result = InterpSample(iy0, iy1, zs, dzs, 2);
+
+        dx = result.dx;
+        dy = result.dy;
+        dz = result.dz;
+        return result.value;
+    }
+
+    template double GradientCoherentNoise3D<NoiseQuality::QUALITY_FAST>(double, double, double,
+        double&, double&, double&, int32) noexcept;
+    template double GradientCoherentNoise3D<NoiseQuality::QUALITY_STD>(double, double, double,
+        double&, double&, double&, int32) noexcept;
+    template double GradientCoherentNoise3D<NoiseQuality::QUALITY_BEST>(double, double, double,
+        double&, double&, double&, int32) noexcept;
+
+    double GradientCoherentNoise3D(double x, double y, double z,
+        double& dx, double& dy, double& dz, int32 seed, NoiseQuality noiseQuality) noexcept {
+        switch (noiseQuality) {
+            case NoiseQuality::QUALITY_FAST:
+                return GradientCoherentNoise3D<NoiseQuality::QUALITY_FAST>(x, y, z, dx, dy, dz, seed);
+            case NoiseQuality::QUALITY_STD:
+                return GradientCoherentNoise3D<NoiseQuality::QUALITY_STD>(x, y, z, dx, dy, dz, seed);
+            case NoiseQuality::QUALITY_BEST:
+            default:
+                return GradientCoherentNoise3D<NoiseQuality::QUALITY_BEST>(x, y, z, dx, dy, dz, seed);
+        }
+    }
+
+    namespace {
+
+        // Signature shared by the scalar and SIMD batch gradient-noise kernels.
+        template <typename Real>
+        using GradientBatchKernel = void (*)(const Real* x, const Real* y, const Real* z,
+            Real* out, int count, int32 seed);
+
+        // Signature shared by the scalar and SIMD two-dimensional batch kernels.
+        template <typename Real>
+        using GradientBatchKernel2D = void (*)(const Real* x, const Real* z, Real* out, int count, int32 seed);
+
+        // Reference kernel; evaluates each input value with the single-point function.
+        template <NoiseQuality Q>
+        void GradientCoherentNoise3DScalar(const double* x, const double* y, const double* z,
+            double* out, int count, int32 seed) noexcept {
+            for (int i = 0; i < count; ++i) {
+                out[i] = GradientCoherentNoise3D<Q>(x[i], y[i], z[i], seed);
+            }
+        }
+
+        template <NoiseQuality Q>
+        void GradientCoherentNoise2DScalar(const double* x, const double* z,
+            double* out, int count, int32 seed) noexcept {
+            for (int i = 0; i < count; ++i) {
+                out[i] = GradientCoherentNoise2D<Q>(x[i], z[i], seed);
+            }
+        }
+
+        // Single-precision copy of the gradient-vector table.  Each row keeps the
+        // (x, y, z, 0) layout of g_randomVectors, so a row fills one 128-bit register.
+        struct alignas(16) FloatVectorTable {
+            std::array<float, 256 * 4> vectors;
+        };
+
+        const float* GetFloatRandomVectors() noexcept {
+            static const FloatVectorTable table = [] {
+                FloatVectorTable result{};
+                for (size_t i = 0; i < result.vectors.size(); ++i) {
+                    result.vectors[i] = static_cast<float>(g_randomVectors[i]);
+                }
+                return result;
+            }();
+            return table.vectors.data();
+        }
+
+        // Single-precision counterpart of GradientNoise3D().
+        inline float GradientNoise3DFloat(const float* randomVectors, float fx, float fy, float fz,
+            int32 ix, int32 iy, int32 iz, int32 seed) noexcept {
+            uint32 vectorIndex = (
+                X_NOISE_GEN * static_cast<uint32>(ix) +
+                Y_NOISE_GEN * static_cast<uint32>(iy) +
+                Z_NOISE_GEN * static_cast<uint32>(iz) +
+                SEED_NOISE_GEN * static_cast<uint32>(seed)
+            );
+            vectorIndex = (vectorIndex ^ (vectorIndex >> SHIFT_NOISE_GEN)) & 0xff;
+
+            const float* gradient = randomVectors + vectorIndex * 4;
+            const float xvPoint = (fx - static_cast<float>(ix));
+            const float yvPoint = (fy - static_cast<float>(iy));
+            const float zvPoint = (fz - static_cast<float>(iz));
+            return (gradient[0] * xvPoint + gradient[1] * yvPoint + gradient[2] * zvPoint) * 2.12f;
+        }
+
+        // Single-precision counterpart of GradientCoherentNoise3D(); this is the
+        // reference that the single-precision SIMD kernels must match exactly.
+        template <NoiseQuality Q>
+        float GradientCoherentNoise3DFloat(const float* randomVectors, float x, float y, float z,
+            int32 seed) noexcept {
+            const int32 x0 = static_cast<int32>(std::floor(x));
+            const int32 x1 = x0 + 1;
+            const int32 y0 = static_cast<int32>(std::floor(y));
+            const int32 y1 = y0 + 1;
+            const int32 z0 = static_cast<int32>(std::floor(z));
+            const int32 z1 = z0 + 1;
+
+            const float xs = SCurve<Q>(x - static_cast<float>(x0));
+            const float ys = SCurve<Q>(y - static_cast<float>(y0));
+            const float zs = SCurve<Q>(z - static_cast<float>(z0));
+
+            float n0 = GradientNoise3DFloat(randomVectors, x, y, z, x0, y0, z0, seed);
+            float n1 = GradientNoise3DFloat(randomVectors, x, y, z, x1, y0, z0, seed);
+            const float ix0 = LinearInterp(n0, n1, xs);
+            n0 = GradientNoise3DFloat(randomVectors, x, y, z, x0, y1, z0, seed);
+            n1 = GradientNoise3DFloat(randomVectors, x, y, z, x1, y1, z0, seed);
+            const float ix1 = LinearInterp(n0, n1, xs);
+            const float iy0 = LinearInterp(ix0, ix1, ys);
+            n0 = GradientNoise3DFloat(randomVectors, x, y, z, x0, y0, z1, seed);
+            n1 = GradientNoise3DFloat(randomVectors, x, y, z, x1, y0, z1, seed);
+            const float ix2 = LinearInterp(n0, n1, xs);
+            n0 = GradientNoise3DFloat(randomVectors, x, y, z, x0, y1, z1, seed);
+            n1 = GradientNoise3DFloat(randomVectors, x, y, z, x1, y1, z1, seed);
+            const float ix3 = LinearInterp(n0, n1, xs);
+            const float iy1 = LinearInterp(ix2, ix3, ys);
+            return LinearInterp(iy0, iy1, zs);
+        }
+
+        template <NoiseQuality Q>
+        void GradientCoherentNoise3DScalar(const float* x, const float* y, const float* z,
+            float* out, int count, int32 seed) noexcept {
+            const float* randomVectors = GetFloatRandomVectors();
+            for (int i = 0; i < count; ++i) {
+                out[i] = GradientCoherentNoise3DFloat<Q>(randomVectors, x[i], y[i], z[i], seed);
+            }
+        }
+
+        // Single-precision counterpart of GradientCoherentNoise2D().
+        template <NoiseQuality Q>
+        float GradientCoherentNoise2DFloat(const float* randomVectors, float x, float z, int32 seed) noexcept {
+            const int32 x0 = static_cast<int32>(std::floor(x));
+            const int32 x1 = x0 + 1;
+            const int32 z0 = static_cast<int32>(std::floor(z));
+            const int32 z1 = z0 + 1;
+
+            const float xs = SCurve<Q>(x - static_cast<float>(x0));
+            const float zs = SCurve<Q>(z - static_cast<float>(z0));
+
+            float n0 = GradientNoise3DFloat(randomVectors, x, 0.0f, z, x0, 0, z0, seed);
+            float n1 = GradientNoise3DFloat(randomVectors, x, 0.0f, z, x1, 0, z0, seed);
+            const float ix0 = LinearInterp(n0, n1, xs);
+            n0 = GradientNoise3DFloat(randomVectors, x, 0.0f, z, x0, 0, z1, seed);
+            n1 = GradientNoise3DFloat(randomVectors, x, 0.0f, z, x1, 0, z1, seed);
+            const float ix1 = LinearInterp(n0, n1, xs);
+            return LinearInterp(ix0, ix1, zs);
+        }
+
+        template <NoiseQuality Q>
+        void GradientCoherentNoise2DScalar(const float* x, const float* z,
+            float* out, int count, int32 seed) noexcept {
+            const float* randomVectors = GetFloatRandomVectors();
+            for (int i = 0; i < count; ++i) {
+                out[i] = GradientCoherentNoise2DFloat<Q>(randomVectors, x[i], z[i], seed);
+            }
+        }
+
+        // The gradient vectors of the eight vertices of one cube of the integer
+        // lattice, in the order in which GradientCoherentNoise3D() visits them
+        // (vertex dx + 2 * dy + 4 * dz is offset by (dx, dy, dz) from the
+        // outer-lower-left vertex). Neighbouring input values usually lie in the
+        // same cube, especially at low frequencies, so the SIMD kernels load the
+        // vectors of a cube once and reuse them while the input values stay in it.
+        template <typename Real>
+        struct CubeGradients {
+            // Integer coordinates of the outer-lower-left vertex.
+            int32 x0, y0, z0;
+            // Determines if the vectors have been loaded.
+            bool isValid;
+            // The gradient vectors; each points to an (x, y, z) row of the vector table.
+            const Real* vectors[8];
+
+            // Determines if the vectors belong to the cube with the given outer-lower-left vertex.
+            inline bool Contains(int32 x, int32 y, int32 z) const noexcept {
+                return isValid && x == x0 && y == y0 && z == z0;
+            }
+
+            // Loads the gradient vectors of the cube with the given outer-lower-left
+            // vertex, hashing each vertex exactly as GradientNoise3D() does.
+            inline void Load(const Real* randomVectors, int32 x, int32 y, int32 z, int32 seed) noexcept {
+                x0 = x;
+                y0 = y;
+                z0 = z;
+                isValid = true;
+                for (int vertex = 0; vertex < 8; ++vertex) {
+                    uint32 vectorIndex = (
+                        X_NOISE_GEN * (static_cast<uint32>(x) + (vertex & 1)) +
+                        Y_NOISE_GEN * (static_cast<uint32>(y) + ((vertex >> 1) & 1)) +
+                        Z_NOISE_GEN * (static_cast<uint32>(z) + (vertex >> 2)) +
+                        SEED_NOISE_GEN * static_cast<uint32>(seed)
+                    );
+                    vectorIndex = (vectorIndex ^ (vectorIndex >> SHIFT_NOISE_GEN)) & 0xff;
+                    vectors[vertex] = randomVectors + vectorIndex * 4;
+                }
+            }
+        };
+
+#ifdef NOISE_SIMD_X86
+
+        // The SIMD kernels below perform exactly the same floating-point
+        // operations, in the same order, as GradientCoherentNoise3D() and
+        // GradientNoise3D(); they must not be compiled with FMA contraction so
+        // that their results stay bit-identical to the scalar reference.
+
+        template <NoiseQuality Q>
+        NOISE_TARGET_SSE41 inline __m128d SCurveSse41(__m128d a) noexcept {
+            if constexpr (Q == NoiseQuality::QUALITY_FAST) {
+                return a;
+            } else if constexpr (Q == NoiseQuality::QUALITY_STD) {
+                return _mm_mul_pd(_mm_mul_pd(a, a), _mm_sub_pd(_mm_set1_pd(3.0), _mm_mul_pd(_mm_set1_pd(2.0), a)));
+            } else {
+                const __m128d a2 = _mm_mul_pd(a, a);
+                const __m128d a3 = _mm_mul_pd(a2, a);
+                const __m128d a4 = _mm_mul_pd(a3, a);
+                const __m128d a5 = _mm_mul_pd(a4, a);
+                return _mm_add_pd(_mm_sub_pd(_mm_mul_pd(_mm_set1_pd(6.0), a5), _mm_mul_pd(_mm_set1_pd(15.0), a4)),
+                    _mm_mul_pd(_mm_set1_pd(10.0), a3));
+            }
+        }
+
+        NOISE_TARGET_SSE41 inline __m128d LinearInterpSse41(__m128d n0, __m128d n1, __m128d a) noexcept {
+            return _mm_add_pd(_mm_mul_pd(_mm_sub_pd(_mm_set1_pd(1.0), a), n0), _mm_mul_pd(a, n1));
+        }
+
+        // Gradient noise at one cube vertex for two input values. @a hash holds the
+        // vertex hashes in its two low lanes; (px, py, pz) is the distance vector.
+        NOISE_TARGET_SSE41 inline __m128d GradientNoiseSse41(__m128i hash, __m128d px, __m128d py, __m128d pz) noexcept {
+            const __m128i index = _mm_and_si128(_mm_xor_si128(hash, _mm_srli_epi32(hash, SHIFT_NOISE_GEN)), _mm_set1_epi32(0xff));
+            const double* v0 = g_randomVectors + _mm_cvtsi128_si32(index) * 4;
+            const double* v1 = g_randomVectors + _mm_extract_epi32(index, 1) * 4;
+            const __m128d gx = _mm_set_pd(v1[0], v0[0]);
+            const __m128d gy = _mm_set_pd(v1[1], v0[1]);
+            const __m128d gz = _mm_set_pd(v1[2], v0[2]);
+            const __m128d dot = _mm_add_pd(_mm_add_pd(_mm_mul_pd(gx, px), _mm_mul_pd(gy, py)), _mm_mul_pd(gz, pz));
+            return _mm_mul_pd(dot, _mm_set1_pd(2.12));
+        }
+
+        template <NoiseQuality Q>
+        NOISE_TARGET_SSE41 void GradientCoherentNoise3DSse41(const double* x, const double* y, const double* z,
+            double* out, int count, int32 seed) noexcept {
+            const __m128i seedHash = _mm_set1_epi32(static_cast<int32>(SEED_NOISE_GEN * static_cast<uint32>(seed)));
+            int i = 0;
+            for (; i + 2 <= count; i += 2) {
+                const __m128d vx = _mm_loadu_pd(x + i);
+                const __m128d vy = _mm_loadu_pd(y + i);
+                const __m128d vz = _mm_loadu_pd(z + i);
+
+                // Integer coordinates of the outer-lower-left cube vertex.
+                const __m128i x0 = _mm_cvtpd_epi32(_mm_floor_pd(vx));
+                const __m128i y0 = _mm_cvtpd_epi32(_mm_floor_pd(vy));
+                const __m128i z0 = _mm_cvtpd_epi32(_mm_floor_pd(vz));
+
+                // Distance vectors from both vertices along each axis.
+                const __m128d px0 = _mm_sub_pd(vx, _mm_cvtepi32_pd(x0));
+                const __m128d py0 = _mm_sub_pd(vy, _mm_cvtepi32_pd(y0));
+                const __m128d pz0 = _mm_sub_pd(vz, _mm_cvtepi32_pd(z0));
+                const __m128i one = _mm_set1_epi32(1);
+                const __m128d px1 = _mm_sub_pd(vx, _mm_cvtepi32_pd(_mm_add_epi32(x0, one)));
+                const __m128d py1 = _mm_sub_pd(vy, _mm_cvtepi32_pd(_mm_add_epi32(y0, one)));
+                const __m128d pz1 = _mm_sub_pd(vz, _mm_cvtepi32_pd(_mm_add_epi32(z0, one)));
+
+                const __m128d xs = SCurveSse41<Q>(px0);
+                const __m128d ys = SCurveSse41<Q>(py0);
+                const __m128d zs = SCurveSse41<Q>(pz0);
+
+                // Hash contributions of each vertex coordinate.
+                const __m128i hx0 = _mm_mullo_epi32(x0, _mm_set1_epi32(X_NOISE_GEN));
+                const __m128i hx1 = _mm_add_epi32(hx0, _mm_set1_epi32(X_NOISE_GEN));
+                const __m128i hy0 = _mm_mullo_epi32(y0, _mm_set1_epi32(Y_NOISE_GEN));
+                const __m128i hy1 = _mm_add_epi32(hy0, _mm_set1_epi32(Y_NOISE_GEN));
+                const __m128i hz0 = _mm_add_epi32(_mm_mullo_epi32(z0, _mm_set1_epi32(Z_NOISE_GEN)), seedHash);
+                const __m128i hz1 = _mm_add_epi32(hz0, _mm_set1_epi32(Z_NOISE_GEN));
+
+                __m128d n0 = GradientNoiseSse41(_mm_add_epi32(_mm_add_epi32(hx0, hy0), hz0), px0, py0, pz0);
+                __m128d n1 = GradientNoiseSse41(_mm_add_epi32(_mm_add_epi32(hx1, hy0), hz0), px1, py0, pz0);
+                const __m128d ix0 = LinearInterpSse41(n0, n1, xs);
+                n0 = GradientNoiseSse41(_mm_add_epi32(_mm_add_epi32(hx0, hy1), hz0), px0, py1, pz0);
+                n1 = GradientNoiseSse41(_mm_add_epi32(_mm_add_epi32(hx1, hy1), hz0), px1, py1, pz0);
+                const __m128d ix1 = LinearInterpSse41(n0, n1, xs);
+                const __m128d iy0 = LinearInterpSse41(ix0, ix1, ys);
+                n0 = GradientNoiseSse41(_mm_add_epi32(_mm_add_epi32(hx0, hy0), hz1), px0, py0, pz1);
+                n1 = GradientNoiseSse41(_mm_add_epi32(_mm_add_epi32(hx1, hy0), hz1), px1, py0, pz1);
+                const __m128d ix2 = LinearInterpSse41(n0, n1, xs);
+                n0 = GradientNoiseSse41(_mm_add_epi32(_mm_add_epi32(hx0, hy1), hz1), px0, py1, pz1);
+                n1 = GradientNoiseSse41(_mm_add_epi32(_mm_add_epi32(hx1, hy1), hz1), px1, py1, pz1);
+                const __m128d ix3 = LinearInterpSse41(n0, n1, xs);
+                const __m128d iy1 = LinearInterpSse41(ix2, ix3, ys);
+
+                _mm_storeu_pd(out + i, LinearInterpSse41(iy0, iy1, zs));
+            }
+            GradientCoherentNoise3DScalar<Q>(x + i, y + i, z + i, out + i, count - i, seed);
+        }
+
+        // The two-dimensional kernels evaluate the plane y = 0 (see
+        // GradientCoherentNoise2D()). They perform the same operations as the
+        // three-dimensional kernels for the four vertices on the lower face of
+        // each cube, with a zero y distance.
+
+        template <NoiseQuality Q>
+        NOISE_TARGET_SSE41 void GradientCoherentNoise2DSse41(const double* x, const double* z,
+            double* out, int count, int32 seed) noexcept {
+            const __m128i seedHash = _mm_set1_epi32(static_cast<int32>(SEED_NOISE_GEN * static_cast<uint32>(seed)));
+            const __m128d py = _mm_setzero_pd();
+            int i = 0;
+            for (; i + 2 <= count; i += 2) {
+                const __m128d vx = _mm_loadu_pd(x + i);
+                const __m128d vz = _mm_loadu_pd(z + i);
+
+                const __m128i x0 = _mm_cvtpd_epi32(_mm_floor_pd(vx));
+                const __m128i z0 = _mm_cvtpd_epi32(_mm_floor_pd(vz));
+
+                const __m128d px0 = _mm_sub_pd(vx, _mm_cvtepi32_pd(x0));
+                const __m128d pz0 = _mm_sub_pd(vz, _mm_cvtepi32_pd(z0));
+                const __m128i one = _mm_set1_epi32(1);
+                const __m128d px1 = _mm_sub_pd(vx, _mm_cvtepi32_pd(_mm_add_epi32(x0, one)));
+                const __m128d pz1 = _mm_sub_pd(vz, _mm_cvtepi32_pd(_mm_add_epi32(z0, one)));
+
+                const __m128d xs = SCurveSse41<Q>(px0);
+                const __m128d zs = SCurveSse41<Q>(pz0);
+
+                const __m128i hx0 = _mm_mullo_epi32(x0, _mm_set1_epi32(X_NOISE_GEN));
+                const __m128i hx1 = _mm_add_epi32(hx0, _mm_set1_epi32(X_NOISE_GEN));
+                const __m128i hz0 = _mm_add_epi32(_mm_mullo_epi32(z0, _mm_set1_epi32(Z_NOISE_GEN)), seedHash);
+                const __m128i hz1 = _mm_add_epi32(hz0, _mm_set1_epi32(Z_NOISE_GEN));
+
+                __m128d n0 = GradientNoiseSse41(_mm_add_epi32(hx0, hz0), px0, py, pz0);
+                __m128d n1 = GradientNoiseSse41(_mm_add_epi32(hx1, hz0), px1, py, pz0);
+                const __m128d ix0 = LinearInterpSse41(n0, n1, xs);
+                n0 = GradientNoiseSse41(_mm_add_epi32(hx0, hz1), px0, py, pz1);
+                n1 = GradientNoiseSse41(_mm_add_epi32(hx1, hz1), px1, py, pz1);
+                const __m128d ix1 = LinearInterpSse41(n0, n1, xs);
+
+                _mm_storeu_pd(out + i, LinearInterpSse41(ix0, ix1, zs));
+            }
+            GradientCoherentNoise2DScalar<Q>(x + i, z + i, out + i, count - i, seed);
+        }
+
+        template <NoiseQuality Q>
+        NOISE_TARGET_AVX2 inline __m256d SCurveAvx2(__m256d a) noexcept {
+            if constexpr (Q == NoiseQuality::QUALITY_FAST) {
+                return a;
+            } else if constexpr (Q == NoiseQuality::QUALITY_STD) {
+                return _mm256_mul_pd(_mm256_mul_pd(a, a), _mm256_sub_pd(_mm256_set1_pd(3.0), _mm256_mul_pd(_mm256_set1_pd(2.0), a)));
+            } else {
+                const __m256d a2 = _mm256_mul_pd(a, a);
+                const __m256d a3 = _mm256_mul_pd(a2, a);
+                const __m256d a4 = _mm256_mul_pd(a3, a);
+                const __m256d a5 = _mm256_mul_pd(a4, a);
+                return _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(_mm256_set1_pd(6.0), a5), _mm256_mul_pd(_mm256_set1_pd(15.0), a4)),
+                    _mm256_mul_pd(_mm256_set1_pd(10.0), a3));
+            }
+        }
+
+        NOISE_TARGET_AVX2 inline __m256d LinearInterpAvx2(__m256d n0, __m256d n1, __m256d a) noexcept {
+            return _mm256_add_pd(_mm256_mul_pd(_mm256_sub_pd(_mm256_set1_pd(1.0), a), n0), _mm256_mul_pd(a, n1));
+        }
+
+        // Gradient noise at one cube vertex for four input values. The gradient
+        // vectors are gathered from the vector table using the vertex hashes.
+        NOISE_TARGET_AVX2 inline __m256d GradientNoiseAvx2(__m128i hash, __m256d px, __m256d py, __m256d pz) noexcept {
+            const __m128i index = _mm_slli_epi32(
+                _mm_and_si128(_mm_xor_si128(hash, _mm_srli_epi32(hash, SHIFT_NOISE_GEN)), _mm_set1_epi32(0xff)), 2);
+            // The masked form of the gather (with every lane enabled) is used because
+            // some compilers warn about the unmasked form reading an undefined source.
+            const __m256d zero = _mm256_setzero_pd();
+            const __m256d mask = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+            const __m256d gx = _mm256_mask_i32gather_pd(zero, g_randomVectors, index, mask, 8);
+            const __m256d gy = _mm256_mask_i32gather_pd(zero, g_randomVectors + 1, index, mask, 8);
+            const __m256d gz = _mm256_mask_i32gather_pd(zero, g_randomVectors + 2, index, mask, 8);
+            const __m256d dot = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(gx, px), _mm256_mul_pd(gy, py)), _mm256_mul_pd(gz, pz));
+            return _mm256_mul_pd(dot, _mm256_set1_pd(2.12));
+        }
+
+        // Gradient noise at one cube vertex for four input values that lie in the
+        // same cube; the vertex's gradient vector is broadcast to every lane.
+        NOISE_TARGET_AVX2 inline __m256d GradientNoiseAvx2(const double* gradient, __m256d px, __m256d py, __m256d pz) noexcept {
+            const __m256d gx = _mm256_broadcast_sd(gradient);
+            const __m256d gy = _mm256_broadcast_sd(gradient + 1);
+            const __m256d gz = _mm256_broadcast_sd(gradient + 2);
+            const __m256d dot = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(gx, px), _mm256_mul_pd(gy, py)), _mm256_mul_pd(gz, pz));
+            return _mm256_mul_pd(dot, _mm256_set1_pd(2.12));
+        }
+
+        // Determines if every lane holds the same integer coordinates.
+        NOISE_TARGET_AVX2 inline bool IsSameCubeAvx2(__m128i x0, __m128i y0, __m128i z0) noexcept {
+            const __m128i sameX = _mm_cmpeq_epi32(x0, _mm_shuffle_epi32(x0, 0));
+            const __m128i sameY = _mm_cmpeq_epi32(y0, _mm_shuffle_epi32(y0, 0));
+            const __m128i sameZ = _mm_cmpeq_epi32(z0, _mm_shuffle_epi32(z0, 0));
+            return _mm_movemask_epi8(_mm_and_si128(_mm_and_si128(sameX, sameY), sameZ)) == 0xffff;
+        }
+
+        template <NoiseQuality Q>
+        NOISE_TARGET_AVX2 void GradientCoherentNoise3DAvx2(const double* x, const double* y, const double* z,
+            double* out, int count, int32 seed) noexcept {
+            const __m128i seedHash = _mm_set1_epi32(static_cast<int32>(SEED_NOISE_GEN * static_cast<uint32>(seed)));
+            CubeGradients<double> cube{};
+            int i = 0;
+            for (; i + 4 <= count; i += 4) {
+                const __m256d vx = _mm256_loadu_pd(x + i);
+                const __m256d vy = _mm256_loadu_pd(y + i);
+                const __m256d vz = _mm256_loadu_pd(z + i);
+
+                // Integer coordinates of the outer-lower-left cube vertex.
+                const __m128i x0 = _mm256_cvtpd_epi32(_mm256_floor_pd(vx));
+                const __m128i y0 = _mm256_cvtpd_epi32(_mm256_floor_pd(vy));
+                const __m128i z0 = _mm256_cvtpd_epi32(_mm256_floor_pd(vz));
+
+                // Distance vectors from both vertices along each axis.
+                const __m256d px0 = _mm256_sub_pd(vx, _mm256_cvtepi32_pd(x0));
+                const __m256d py0 = _mm256_sub_pd(vy, _mm256_cvtepi32_pd(y0));
+                const __m256d pz0 = _mm256_sub_pd(vz, _mm256_cvtepi32_pd(z0));
+                const __m128i one = _mm_set1_epi32(1);
+                const __m256d px1 = _mm256_sub_pd(vx, _mm256_cvtepi32_pd(_mm_add_epi32(x0, one)));
+                const __m256d py1 = _mm256_sub_pd(vy, _mm256_cvtepi32_pd(_mm_add_epi32(y0, one)));
+                const __m256d pz1 = _mm256_sub_pd(vz, _mm256_cvtepi32_pd(_mm_add_epi32(z0, one)));
+
+                const __m256d xs = SCurveAvx2<Q>(px0);
+                const __m256d ys = SCurveAvx2<Q>(py0);
+                const __m256d zs = SCurveAvx2<Q>(pz0);
+
+                // Gradient noise at each vertex of the cube, in the order of cube.vectors.
+                __m256d n[8];
+                if (IsSameCubeAvx2(x0, y0, z0)) {
+                    const int32 cubeX = _mm_cvtsi128_si32(x0);
+                    const int32 cubeY = _mm_cvtsi128_si32(y0);
+                    const int32 cubeZ = _mm_cvtsi128_si32(z0);
+                    if (!cube.Contains(cubeX, cubeY, cubeZ)) {
+                        cube.Load(g_randomVectors, cubeX, cubeY, cubeZ, seed);
+                    }
+                    for (int vertex = 0; vertex < 8; ++vertex) {
+                        n[vertex] = GradientNoiseAvx2(cube.vectors[vertex], (vertex & 1) ? px1 : px0,
+                            (vertex & 2) ? py1 : py0, (vertex & 4) ? pz1 : pz0);
+                    }
+                } else {
+                    // Hash contributions of each vertex coordinate.
+                    const __m128i hx0 = _mm_mullo_epi32(x0, _mm_set1_epi32(X_NOISE_GEN));
+                    const __m128i hx1 = _mm_add_epi32(hx0, _mm_set1_epi32(X_NOISE_GEN));
+                    const __m128i hy0 = _mm_mullo_epi32(y0, _mm_set1_epi32(Y_NOISE_GEN));
+                    const __m128i hy1 = _mm_add_epi32(hy0, _mm_set1_epi32(Y_NOISE_GEN));
+                    const __m128i hz0 = _mm_add_epi32(_mm_mullo_epi32(z0, _mm_set1_epi32(Z_NOISE_GEN)), seedHash);
+                    const __m128i hz1 = _mm_add_epi32(hz0, _mm_set1_epi32(Z_NOISE_GEN));
+
+                    n[0] = GradientNoiseAvx2(_mm_add_epi32(_mm_add_epi32(hx0, hy0), hz0), px0, py0, pz0);
+                    n[1] = GradientNoiseAvx2(_mm_add_epi32(_mm_add_epi32(hx1, hy0), hz0), px1, py0, pz0);
+                    n[2] = GradientNoiseAvx2(_mm_add_epi32(_mm_add_epi32(hx0, hy1), hz0), px0, py1, pz0);
+                    n[3] = GradientNoiseAvx2(_mm_add_epi32(_mm_add_epi32(hx1, hy1), hz0), px1, py1, pz0);
+                    n[4] = GradientNoiseAvx2(_mm_add_epi32(_mm_add_epi32(hx0, hy0), hz1), px0, py0, pz1);
+                    n[5] = GradientNoiseAvx2(_mm_add_epi32(_mm_add_epi32(hx1, hy0), hz1), px1, py0, pz1);
+                    n[6] = GradientNoiseAvx2(_mm_add_epi32(_mm_add_epi32(hx0, hy1), hz1), px0, py1, pz1);
+                    n[7] = GradientNoiseAvx2(_mm_add_epi32(_mm_add_epi32(hx1, hy1), hz1), px1, py1, pz1);
+                }
+
+                const __m256d ix0 = LinearInterpAvx2(n[0], n[1], xs);
+                const __m256d ix1 = LinearInterpAvx2(n[2], n[3], xs);
+                const __m256d iy0 = LinearInterpAvx2(ix0, ix1, ys);
+                const __m256d ix2 = LinearInterpAvx2(n[4], n[5], xs);
+                const __m256d ix3 = LinearInterpAvx2(n[6], n[7], xs);
+                const __m256d iy1 = LinearInterpAvx2(ix2, ix3, ys);
+
+                _mm256_storeu_pd(out + i, LinearInterpAvx2(iy0, iy1, zs));
+            }
+            GradientCoherentNoise3DScalar<Q>(x + i, y + i, z + i, out + i, count - i, seed);
+        }
+
+        template <NoiseQuality Q>
+        NOISE_TARGET_AVX2 void GradientCoherentNoise2DAvx2(const double* x, const double* z,
+            double* out, int count, int32 seed) noexcept {
+            const __m128i seedHash = _mm_set1_epi32(static_cast<int32>(SEED_NOISE_GEN * static_cast<uint32>(seed)));
+            const __m256d py = _mm256_setzero_pd();
+            CubeGradients<double> cube{};
+            int i = 0;
+            for (; i + 4 <= count; i += 4) {
+                const __m256d vx = _mm256_loadu_pd(x + i);
+                const __m256d vz = _mm256_loadu_pd(z + i);
+
+                const __m128i x0 = _mm256_cvtpd_epi32(_mm256_floor_pd(vx));
+                const __m128i z0 = _mm256_cvtpd_epi32(_mm256_floor_pd(vz));
+
+                const __m256d px0 = _mm256_sub_pd(vx, _mm256_cvtepi32_pd(x0));
+                const __m256d pz0 = _mm256_sub_pd(vz, _mm256_cvtepi32_pd(z0));
+                const __m128i one = _mm_set1_epi32(1);
+                const __m256d px1 = _mm256_sub_pd(vx, _mm256_cvtepi32_pd(_mm_add_epi32(x0, one)));
+                const __m256d pz1 = _mm256_sub_pd(vz, _mm256_cvtepi32_pd(_mm_add_epi32(z0, one)));
+
+                const __m256d xs = SCurveAvx2<Q>(px0);
+                const __m256d zs = SCurveAvx2<Q>(pz0);
+
+                // Gradient noise at each vertex of the lower face of the cube.
+                __m256d n0, n1, n2, n3;
+                if (IsSameCubeAvx2(x0, _mm_setzero_si128(), z0)) {
+                    const int32 cubeX = _mm_cvtsi128_si32(x0);
+                    const int32 cubeZ = _mm_cvtsi128_si32(z0);
+                    if (!cube.Contains(cubeX, 0, cubeZ)) {
+                        cube.Load(g_randomVectors, cubeX, 0, cubeZ, seed);
+                    }
+                    n0 = GradientNoiseAvx2(cube.vectors[0], px0, py, pz0);
+                    n1 = GradientNoiseAvx2(cube.vectors[1], px1, py, pz0);
+                    n2 = GradientNoiseAvx2(cube.vectors[4], px0, py, pz1);
+                    n3 = GradientNoiseAvx2(cube.vectors[5], px1, py, pz1);
+                } else {
+                    const __m128i hx0 = _mm_mullo_epi32(x0, _mm_set1_epi32(X_NOISE_GEN));
+                    const __m128i hx1 = _mm_add_epi32(hx0, _mm_set1_epi32(X_NOISE_GEN));
+                    const __m128i hz0 = _mm_add_epi32(_mm_mullo_epi32(z0, _mm_set1_epi32(Z_NOISE_GEN)), seedHash);
+                    const __m128i hz1 = _mm_add_epi32(hz0, _mm_set1_epi32(Z_NOISE_GEN));
+
+                    n0 = GradientNoiseAvx2(_mm_add_epi32(hx0, hz0), px0, py, pz0);
+                    n1 = GradientNoiseAvx2(_mm_add_epi32(hx1, hz0), px1, py, pz0);
+                    n2 = GradientNoiseAvx2(_mm_add_epi32(hx0, hz1), px0, py, pz1);
+                    n3 = GradientNoiseAvx2(_mm_add_epi32(hx1, hz1), px1, py, pz1);
+                }
+
+                const __m256d ix0 = LinearInterpAvx2(n0, n1, xs);
+                const __m256d ix1 = LinearInterpAvx2(n2, n3, xs);
+
+                _mm256_storeu_pd(out + i, LinearInterpAvx2(ix0, ix1, zs));
+            }
+            GradientCoherentNoise2DScalar<Q>(x + i, z + i, out + i, count - i, seed);
+        }
+
+        template <NoiseQuality Q>
+        NOISE_TARGET_SSE41 inline __m128 SCurveSse41(__m128 a) noexcept {
+            if constexpr (Q == NoiseQuality::QUALITY_FAST) {
+                return a;
+            } else if constexpr (Q == NoiseQuality::QUALITY_STD) {
+                return _mm_mul_ps(_mm_mul_ps(a, a), _mm_sub_ps(_mm_set1_ps(3.0f), _mm_mul_ps(_mm_set1_ps(2.0f), a)));
+            } else {
+                const __m128 a2 = _mm_mul_ps(a, a);
+                const __m128 a3 = _mm_mul_ps(a2, a);
+                const __m128 a4 = _mm_mul_ps(a3, a);
+                const __m128 a5 = _mm_mul_ps(a4, a);
+                return _mm_add_ps(_mm_sub_ps(_mm_mul_ps(_mm_set1_ps(6.0f), a5), _mm_mul_ps(_mm_set1_ps(15.0f), a4)),
+                    _mm_mul_ps(_mm_set1_ps(10.0f), a3));
+            }
+        }
+
+        NOISE_TARGET_SSE41 inline __m128 LinearInterpSse41(__m128 n0, __m128 n1, __m128 a) noexcept {
+            return _mm_add_ps(_mm_mul_ps(_mm_sub_ps(_mm_set1_ps(1.0f), a), n0), _mm_mul_ps(a, n1));
+        }
+
+        // Single-precision gradient noise at one cube vertex for four input
+        // values.  The four table rows are loaded whole and transposed into
+        // x, y, and z gradient registers.
+        NOISE_TARGET_SSE41 inline __m128 GradientNoiseSse41(const float* randomVectors, __m128i hash,
+            __m128 px, __m128 py, __m128 pz) noexcept {
+            const __m128i index = _mm_and_si128(_mm_xor_si128(hash, _mm_srli_epi32(hash, SHIFT_NOISE_GEN)), _mm_set1_epi32(0xff));
+            __m128 gx = _mm_load_ps(randomVectors + _mm_cvtsi128_si32(index) * 4);
+            __m128 gy = _mm_load_ps(randomVectors + _mm_extract_epi32(index, 1) * 4);
+            __m128 gz = _mm_load_ps(randomVectors + _mm_extract_epi32(index, 2) * 4);
+            __m128 gw = _mm_load_ps(randomVectors + _mm_extract_epi32(index, 3) * 4);
+            _MM_TRANSPOSE4_PS(gx, gy, gz, gw);
+            const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(gx, px), _mm_mul_ps(gy, py)), _mm_mul_ps(gz, pz));
+            return _mm_mul_ps(dot, _mm_set1_ps(2.12f));
+        }
+
+        template <NoiseQuality Q>
+        NOISE_TARGET_SSE41 void GradientCoherentNoise3DSse41(const float* x, const float* y, const float* z,
+            float* out, int count, int32 seed) noexcept {
+            const float* randomVectors = GetFloatRandomVectors();
+            const __m128i seedHash = _mm_set1_epi32(static_cast<int32>(SEED_NOISE_GEN * static_cast<uint32>(seed)));
+            int i = 0;
+            for (; i + 4 <= count; i += 4) {
+                const __m128 vx = _mm_loadu_ps(x + i);
+                const __m128 vy = _mm_loadu_ps(y + i);
+                const __m128 vz = _mm_loadu_ps(z + i);
+
+                const __m128i x0 = _mm_cvtps_epi32(_mm_floor_ps(vx));
+                const __m128i y0 = _mm_cvtps_epi32(_mm_floor_ps(vy));
+                const __m128i z0 = _mm_cvtps_epi32(_mm_floor_ps(vz));
+
+                const __m128 px0 = _mm_sub_ps(vx, _mm_cvtepi32_ps(x0));
+                const __m128 py0 = _mm_sub_ps(vy, _mm_cvtepi32_ps(y0));
+                const __m128 pz0 = _mm_sub_ps(vz, _mm_cvtepi32_ps(z0));
+                const __m128i one = _mm_set1_epi32(1);
+                const __m128 px1 = _mm_sub_ps(vx, _mm_cvtepi32_ps(_mm_add_epi32(x0, one)));
+                const __m128 py1 = _mm_sub_ps(vy, _mm_cvtepi32_ps(_mm_add_epi32(y0, one)));
+                const __m128 pz1 = _mm_sub_ps(vz, _mm_cvtepi32_ps(_mm_add_epi32(z0, one)));
+
+                const __m128 xs = SCurveSse41<Q>(px0);
+                const __m128 ys = SCurveSse41<Q>(py0);
+                const __m128 zs = SCurveSse41<Q>(pz0);
+
+                const __m128i hx0 = _mm_mullo_epi32(x0, _mm_set1_epi32(X_NOISE_GEN));
+                const __m128i hx1 = _mm_add_epi32(hx0, _mm_set1_epi32(X_NOISE_GEN));
+                const __m128i hy0 = _mm_mullo_epi32(y0, _mm_set1_epi32(Y_NOISE_GEN));
+                const __m128i hy1 = _mm_add_epi32(hy0, _mm_set1_epi32(Y_NOISE_GEN));
+                const __m128i hz0 = _mm_add_epi32(_mm_mullo_epi32(z0, _mm_set1_epi32(Z_NOISE_GEN)), seedHash);
+                const __m128i hz1 = _mm_add_epi32(hz0, _mm_set1_epi32(Z_NOISE_GEN));
+
+                __m128 n0 = GradientNoiseSse41(randomVectors, _mm_add_epi32(_mm_add_epi32(hx0, hy0), hz0), px0, py0, pz0);
+                __m128 n1 = GradientNoiseSse41(randomVectors, _mm_add_epi32(_mm_add_epi32(hx1, hy0), hz0), px1, py0, pz0);
+                const __m128 ix0 = LinearInterpSse41(n0, n1, xs);
+                n0 = GradientNoiseSse41(randomVectors, _mm_add_epi32(_mm_add_epi32(hx0, hy1), hz0), px0, py1, pz0);
+                n1 = GradientNoiseSse41(randomVectors, _mm_add_epi32(_mm_add_epi32(hx1, hy1), hz0), px1, py1, pz0);
+                const __m128 ix1 = LinearInterpSse41(n0, n1, xs);
+                const __m128 iy0 = LinearInterpSse41(ix0, ix1, ys);
+                n0 = GradientNoiseSse41(randomVectors, _mm_add_epi32(_mm_add_epi32(hx0, hy0), hz1), px0, py0, pz1);
+                n1 = GradientNoiseSse41(randomVectors, _mm_add_epi32(_mm_add_epi32(hx1, hy0), hz1), px1, py0, pz1);
+                const __m128 ix2 = LinearInterpSse41(n0, n1, xs);
+                n0 = GradientNoiseSse41(randomVectors, _mm_add_epi32(_mm_add_epi32(hx0, hy1), hz1), px0, py1, pz1);
+                n1 = GradientNoiseSse41(randomVectors, _mm_add_epi32(_mm_add_epi32(hx1, hy1), hz1), px1, py1, pz1);
+                const __m128 ix3 = LinearInterpSse41(n0, n1, xs);
+                const __m128 iy1 = LinearInterpSse41(ix2, ix3, ys);
+
+                _mm_storeu_ps(out + i, LinearInterpSse41(iy0, iy1, zs));
+            }
+            GradientCoherentNoise3DScalar<Q>(x + i, y + i, z + i, out + i, count - i, seed);
+        }
+
+        template <NoiseQuality Q>
+        NOISE_TARGET_SSE41 void GradientCoherentNoise2DSse41(const float* x, const float* z,
+            float* out, int count, int32 seed) noexcept {
+            const float* randomVectors = GetFloatRandomVectors();
+            const __m128i seedHash = _mm_set1_epi32(static_cast<int32>(SEED_NOISE_GEN * static_cast<uint32>(seed)));
+            const __m128 py = _mm_setzero_ps();
+            int i = 0;
+            for (; i + 4 <= count; i += 4) {
+                const __m128 vx = _mm_loadu_ps(x + i);
+                const __m128 vz = _mm_loadu_ps(z + i);
+
+                const __m128i x0 = _mm_cvtps_epi32(_mm_floor_ps(vx));
+                const __m128i z0 = _mm_cvtps_epi32(_mm_floor_ps(vz));
+
+                const __m128 px0 = _mm_sub_ps(vx, _mm_cvtepi32_ps(x0));
+                const __m128 pz0 = _mm_sub_ps(vz, _mm_cvtepi32_ps(z0));
+                const __m128i one = _mm_set1_epi32(1);
+                const __m128 px1 = _mm_sub_ps(vx, _mm_cvtepi32_ps(_mm_add_epi32(x0, one)));
+                const __m128 pz1 = _mm_sub_ps(vz, _mm_cvtepi32_ps(_mm_add_epi32(z0, one)));
+
+                const __m128 xs = SCurveSse41<Q>(px0);
+                const __m128 zs = SCurveSse41<Q>(pz0);
+
+                const __m128i hx0 = _mm_mullo_epi32(x0, _mm_set1_epi32(X_NOISE_GEN));
+                const __m128i hx1 = _mm_add_epi32(hx0, _mm_set1_epi32(X_NOISE_GEN));
+                const __m128i hz0 = _mm_add_epi32(_mm_mullo_epi32(z0, _mm_set1_epi32(Z_NOISE_GEN)), seedHash);
+                const __m128i hz1 = _mm_add_epi32(hz0, _mm_set1_epi32(Z_NOISE_GEN));
+
+                __m128 n0 = GradientNoiseSse41(randomVectors, _mm_add_epi32(hx0, hz0), px0, py, pz0);
+                __m128 n1 = GradientNoiseSse41(randomVectors, _mm_add_epi32(hx1, hz0), px1, py, pz0);
+                const __m128 ix0 = LinearInterpSse41(n0, n1, xs);
+                n0 = GradientNoiseSse41(randomVectors, _mm_add_epi32(hx0, hz1), px0, py, pz1);
+                n1 = GradientNoiseSse41(randomVectors, _mm_add_epi32(hx1, hz1), px1, py, pz1);
+                const __m128 ix1 = LinearInterpSse41(n0, n1, xs);
+
+                _mm_storeu_ps(out + i, LinearInterpSse41(ix0, ix1, zs));
+            }
+            GradientCoherentNoise2DScalar<Q>(x + i, z + i, out + i, count - i, seed);
+        }
+
+        template <NoiseQuality Q>
+        NOISE_TARGET_AVX2 inline __m256 SCurveAvx2(__m256 a) noexcept {
+            if constexpr (Q == NoiseQuality::QUALITY_FAST) {
+                return a;
+            } else if constexpr (Q == NoiseQuality::QUALITY_STD) {
+                return _mm256_mul_ps(_mm256_mul_ps(a, a), _mm256_sub_ps(_mm256_set1_ps(3.0f), _mm256_mul_ps(_mm256_set1_ps(2.0f), a)));
+            } else {
+                const __m256 a2 = _mm256_mul_ps(a, a);
+                const __m256 a3 = _mm256_mul_ps(a2, a);
+                const __m256 a4 = _mm256_mul_ps(a3, a);
+                const __m256 a5 = _mm256_mul_ps(a4, a);
+                return _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(_mm256_set1_ps(6.0f), a5), _mm256_mul_ps(_mm256_set1_ps(15.0f), a4)),
+                    _mm256_mul_ps(_mm256_set1_ps(10.0f), a3));
+            }
+        }
+
+        NOISE_TARGET_AVX2 inline __m256 LinearInterpAvx2(__m256 n0, __m256 n1, __m256 a) noexcept {
+            return _mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), a), n0), _mm256_mul_ps(a, n1));
+        }
+
+        // Single-precision gradient noise at one cube vertex for eight input values.
+        NOISE_TARGET_AVX2 inline __m256 GradientNoiseAvx2(const float* randomVectors, __m256i hash,
+            __m256 px, __m256 py, __m256 pz) noexcept {
+            const __m256i index = _mm256_slli_epi32(
+                _mm256_and_si256(_mm256_xor_si256(hash, _mm256_srli_epi32(hash, SHIFT_NOISE_GEN)), _mm256_set1_epi32(0xff)), 2);
+            const __m256 zero = _mm256_setzero_ps();
+            const __m256 mask = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            const __m256 gx = _mm256_mask_i32gather_ps(zero, randomVectors, index, mask, 4);
+            const __m256 gy = _mm256_mask_i32gather_ps(zero, randomVectors + 1, index, mask, 4);
+            const __m256 gz = _mm256_mask_i32gather_ps(zero, randomVectors + 2, index, mask, 4);
+            const __m256 dot = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(gx, px), _mm256_mul_ps(gy, py)), _mm256_mul_ps(gz, pz));
+            return _mm256_mul_ps(dot, _mm256_set1_ps(2.12f));
+        }
+
+        // Single-precision gradient noise at one cube vertex for eight input values
+        // that lie in the same cube.
+        NOISE_TARGET_AVX2 inline __m256 GradientNoiseAvx2(const float* gradient, __m256 px, __m256 py, __m256 pz) noexcept {
+            const __m256 gx = _mm256_broadcast_ss(gradient);
+            const __m256 gy = _mm256_broadcast_ss(gradient + 1);
+            const __m256 gz = _mm256_broadcast_ss(gradient + 2);
+            const __m256 dot = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(gx, px), _mm256_mul_ps(gy, py)), _mm256_mul_ps(gz, pz));
+            return _mm256_mul_ps(dot, _mm256_set1_ps(2.12f));
+        }
+
+        NOISE_TARGET_AVX2 inline bool IsSameCubeAvx2(__m256i x0, __m256i y0, __m256i z0) noexcept {
+            const __m256i sameX = _mm256_cmpeq_epi32(x0, _mm256_broadcastd_epi32(_mm256_castsi256_si128(x0)));
+            const __m256i sameY = _mm256_cmpeq_epi32(y0, _mm256_broadcastd_epi32(_mm256_castsi256_si128(y0)));
+            const __m256i sameZ = _mm256_cmpeq_epi32(z0, _mm256_broadcastd_epi32(_mm256_castsi256_si128(z0)));
+            return _mm256_movemask_epi8(_mm256_and_si256(_mm256_and_si256(sameX, sameY), sameZ)) == -1;
+        }
+
+        template <NoiseQuality Q>
+        NOISE_TARGET_AVX2 void GradientCoherentNoise3DAvx2(const float* x, const float* y, const float* z,
+            float* out, int count, int32 seed) noexcept {
+            const float* randomVectors = GetFloatRandomVectors();
+            const __m256i seedHash = _mm256_set1_epi32(static_cast<int32>(SEED_NOISE_GEN * static_cast<uint32>(seed)));
+            CubeGradients<float> cube{};
+            int i = 0;
+            for (; i + 8 <= count; i += 8) {
+                const __m256 vx = _mm256_loadu_ps(x + i);
+                const __m256 vy = _mm256_loadu_ps(y + i);
+                const __m256 vz = _mm256_loadu_ps(z + i);
+
+                const __m256i x0 = _mm256_cvtps_epi32(_mm256_floor_ps(vx));
+                const __m256i y0 = _mm256_cvtps_epi32(_mm256_floor_ps(vy));
+                const __m256i z0 = _mm256_cvtps_epi32(_mm256_floor_ps(vz));
+
+                const __m256 px0 = _mm256_sub_ps(vx, _mm256_cvtepi32_ps(x0));
+                const __m256 py0 = _mm256_sub_ps(vy, _mm256_cvtepi32_ps(y0));
+                const __m256 pz0 = _mm256_sub_ps(vz, _mm256_cvtepi32_ps(z0));
+                const __m256i one = _mm256_set1_epi32(1);
+                const __m256 px1 = _mm256_sub_ps(vx, _mm256_cvtepi32_ps(_mm256_add_epi32(x0, one)));
+                const __m256 py1 = _mm256_sub_ps(vy, _mm256_cvtepi32_ps(_mm256_add_epi32(y0, one)));
+                const __m256 pz1 = _mm256_sub_ps(vz, _mm256_cvtepi32_ps(_mm256_add_epi32(z0, one)));
+
+                const __m256 xs = SCurveAvx2<Q>(px0);
+                const __m256 ys = SCurveAvx2<Q>(py0);
+                const __m256 zs = SCurveAvx2<Q>(pz0);
+
+                __m256 n[8];
+                if (IsSameCubeAvx2(x0, y0, z0)) {
+                    const int32 cubeX = _mm256_cvtsi256_si32(x0);
+                    const int32 cubeY = _mm256_cvtsi256_si32(y0);
+                    const int32 cubeZ = _mm256_cvtsi256_si32(z0);
+                    if (!cube.Contains(cubeX, cubeY, cubeZ)) {
+                        cube.Load(randomVectors, cubeX, cubeY, cubeZ, seed);
+                    }
+                    for (int vertex = 0; vertex < 8; ++vertex) {
+                        n[vertex] = GradientNoiseAvx2(cube.vectors[vertex], (vertex & 1) ? px1 : px0,
+                            (vertex & 2) ? py1 : py0, (vertex & 4) ? pz1 : pz0);
+                    }
+                } else {
+                    const __m256i hx0 = _mm256_mullo_epi32(x0, _mm256_set1_epi32(X_NOISE_GEN));
+                    const __m256i hx1 = _mm256_add_epi32(hx0, _mm256_set1_epi32(X_NOISE_GEN));
+                    const __m256i hy0 = _mm256_mullo_epi32(y0, _mm256_set1_epi32(Y_NOISE_GEN));
+                    const __m256i hy1 = _mm256_add_epi32(hy0, _mm256_set1_epi32(Y_NOISE_GEN));
+                    const __m256i hz0 = _mm256_add_epi32(_mm256_mullo_epi32(z0, _mm256_set1_epi32(Z_NOISE_GEN)), seedHash);
+                    const __m256i hz1 = _mm256_add_epi32(hz0, _mm256_set1_epi32(Z_NOISE_GEN));
+
+                    n[0] = GradientNoiseAvx2(randomVectors, _mm256_add_epi32(_mm256_add_epi32(hx0, hy0), hz0), px0, py0, pz0);
+                    n[1] = GradientNoiseAvx2(randomVectors, _mm256_add_epi32(_mm256_add_epi32(hx1, hy0), hz0), px1, py0, pz0);
+                    n[2] = GradientNoiseAvx2(randomVectors, _mm256_add_epi32(_mm256_add_epi32(hx0, hy1), hz0), px0, py1, pz0);
+                    n[3] = GradientNoiseAvx2(randomVectors, _mm256_add_epi32(_mm256_add_epi32(hx1, hy1), hz0), px1, py1, pz0);
+                    n[4] = GradientNoiseAvx2(randomVectors, _mm256_add_epi32(_mm256_add_epi32(hx0, hy0), hz1), px0, py0, pz1);
+                    n[5] = GradientNoiseAvx2(randomVectors, _mm256_add_epi32(_mm256_add_epi32(hx1, hy0), hz1), px1, py0, pz1);
+                    n[6] = GradientNoiseAvx2(randomVectors, _mm256_add_epi32(_mm256_add_epi32(hx0, hy1), hz1), px0, py1, pz1);
+                    n[7] = GradientNoiseAvx2(randomVectors, _mm256_add_epi32(_mm256_add_epi32(hx1, hy1), hz1), px1, py1, pz1);
+                }
+
+                const __m256 ix0 = LinearInterpAvx2(n[0], n[1], xs);
+                const __m256 ix1 = LinearInterpAvx2(n[2], n[3], xs);
+                const __m256 iy0 = LinearInterpAvx2(ix0, ix1, ys);
+                const __m256 ix2 = LinearInterpAvx2(n[4], n[5], xs);
+                const __m256 ix3 = LinearInterpAvx2(n[6], n[7], xs);
+                const __m256 iy1 = LinearInterpAvx2(ix2, ix3, ys);
+
+                _mm256_storeu_ps(out + i, LinearInterpAvx2(iy0, iy1, zs));
+            }
+            GradientCoherentNoise3DScalar<Q>(x + i, y + i, z + i, out + i, count - i, seed);
+        }
+
+        template <NoiseQuality Q>
+        NOISE_TARGET_AVX2 void GradientCoherentNoise2DAvx2(const float* x, const float* z,
+            float* out, int count, int32 seed) noexcept {
+            const float* randomVectors = GetFloatRandomVectors();
+            const __m256i seedHash = _mm256_set1_epi32(static_cast<int32>(SEED_NOISE_GEN * static_cast<uint32>(seed)));
+            const __m256 py = _mm256_setzero_ps();
+            CubeGradients<float> cube{};
+            int i = 0;
+            for (; i + 8 <= count; i += 8) {
+                const __m256 vx = _mm256_loadu_ps(x + i);
+                const __m256 vz = _mm256_loadu_ps(z + i);
+
+                const __m256i x0 = _mm256_cvtps_epi32(_mm256_floor_ps(vx));
+                const __m256i z0 = _mm256_cvtps_epi32(_mm256_floor_ps(vz));
+
+                const __m256 px0 = _mm256_sub_ps(vx, _mm256_cvtepi32_ps(x0));
+                const __m256 pz0 = _mm256_sub_ps(vz, _mm256_cvtepi32_ps(z0));
+                const __m256i one = _mm256_set1_epi32(1);
+                const __m256 px1 = _mm256_sub_ps(vx, _mm256_cvtepi32_ps(_mm256_add_epi32(x0, one)));
+                const __m256 pz1 = _mm256_sub_ps(vz, _mm256_cvtepi32_ps(_mm256_add_epi32(z0, one)));
+
+                const __m256 xs = SCurveAvx2<Q>(px0);
+                const __m256 zs = SCurveAvx2<Q>(pz0);
+
+                __m256 n0, n1, n2, n3;
+                if (IsSameCubeAvx2(x0, _mm256_setzero_si256(), z0)) {
+                    const int32 cubeX = _mm256_cvtsi256_si32(x0);
+                    const int32 cubeZ = _mm256_cvtsi256_si32(z0);
+                    if (!cube.Contains(cubeX, 0, cubeZ)) {
+                        cube.Load(randomVectors, cubeX, 0, cubeZ, seed);
+                    }
+                    n0 = GradientNoiseAvx2(cube.vectors[0], px0, py, pz0);
+                    n1 = GradientNoiseAvx2(cube.vectors[1], px1, py, pz0);
+                    n2 = GradientNoiseAvx2(cube.vectors[4], px0, py, pz1);
+                    n3 = GradientNoiseAvx2(cube.vectors[5], px1, py, pz1);
+                } else {
+                    const __m256i hx0 = _mm256_mullo_epi32(x0, _mm256_set1_epi32(X_NOISE_GEN));
+                    const __m256i hx1 = _mm256_add_epi32(hx0, _mm256_set1_epi32(X_NOISE_GEN));
+                    const __m256i hz0 = _mm256_add_epi32(_mm256_mullo_epi32(z0, _mm256_set1_epi32(Z_NOISE_GEN)), seedHash);
+                    const __m256i hz1 = _mm256_add_epi32(hz0, _mm256_set1_epi32(Z_NOISE_GEN));
+
+                    n0 = GradientNoiseAvx2(randomVectors, _mm256_add_epi32(hx0, hz0), px0, py, pz0);
+                    n1 = GradientNoiseAvx2(randomVectors, _mm256_add_epi32(hx1, hz0), px1, py, pz0);
+                    n2 = GradientNoiseAvx2(randomVectors, _mm256_add_epi32(hx0, hz1), px0, py, pz1);
+                    n3 = GradientNoiseAvx2(randomVectors, _mm256_add_epi32(hx1, hz1), px1, py, pz1);
+                }
+
+                const __m256 ix0 = LinearInterpAvx2(n0, n1, xs);
+                const __m256 ix1 = LinearInterpAvx2(n2, n3, xs);
+
+                _mm256_storeu_ps(out + i, LinearInterpAvx2(ix0, ix1, zs));
+            }
+            GradientCoherentNoise2DScalar<Q>(x + i, z + i, out + i, count - i, seed);
+        }
+
+#endif // NOISE_SIMD_X86
+
+        // Selects the fastest batch kernel that the processor supports.
+        template <typename Real, NoiseQuality Q>
+        GradientBatchKernel<Real> SelectGradientBatchKernel() noexcept {
+#ifdef NOISE_SIMD_X86
+            if (simd::CpuSupportsAvx2()) {
+                return GradientCoherentNoise3DAvx2<Q>;
+            }
+            if (simd::CpuSupportsSse41()) {
+                return GradientCoherentNoise3DSse41<Q>;
+            }
+#endif
+            return GradientCoherentNoise3DScalar<Q>;
+        }
+
+        // Selects the fastest two-dimensional batch kernel that the processor supports.
+        template <typename Real, NoiseQuality Q>
+        GradientBatchKernel2D<Real> SelectGradientBatchKernel2D() noexcept {
+#ifdef NOISE_SIMD_X86
+            if (simd::CpuSupportsAvx2()) {
+                return GradientCoherentNoise2DAvx2<Q>;
+            }
+            if (simd::CpuSupportsSse41()) {
+                return GradientCoherentNoise2DSse41<Q>;
+            }
+#endif
+            return GradientCoherentNoise2DScalar<Q>;
+        }
+
+    }
+
+    template <NoiseQuality Q>
+    void GradientCoherentNoise3D(const double* x, const double* y, const double* z,
+        double* out, int count, int32 seed) noexcept {
+        static const GradientBatchKernel<double> kernel = SelectGradientBatchKernel<double, Q>();
+        kernel(x, y, z, out, count, seed);
+    }
+
+    template <NoiseQuality Q>
+    void GradientCoherentNoise3D(const float* x, const float* y, const float* z,
+        float* out, int count, int32 seed) noexcept {
+        static const GradientBatchKernel<float> kernel = SelectGradientBatchKernel<float, Q>();
+        kernel(x, y, z, out, count, seed);
+    }
+
+    template void GradientCoherentNoise3D<NoiseQuality::QUALITY_FAST>(const double*, const double*, const double*,
+        double*, int, int32) noexcept;
+    template void GradientCoherentNoise3D<NoiseQuality::QUALITY_STD>(const double*, const double*, const double*,
+        double*, int, int32) noexcept;
+    template void GradientCoherentNoise3D<NoiseQuality::QUALITY_BEST>(const double*, const double*, const double*,
+        double*, int, int32) noexcept;
+    template void GradientCoherentNoise3D<NoiseQuality::QUALITY_FAST>(const float*, const float*, const float*,
+        float*, int, int32) noexcept;
+    template void GradientCoherentNoise3D<NoiseQuality::QUALITY_STD>(const float*, const float*, const float*,
+        float*, int, int32) noexcept;
+    template void GradientCoherentNoise3D<NoiseQuality::QUALITY_BEST>(const float*, const float*, const float*,
+        float*, int, int32) noexcept;
+
+    void GradientCoherentNoise3D(const double* x, const double* y, const double* z,
+        double* out, int count, int32 seed, NoiseQuality noiseQuality) noexcept {
+        switch (noiseQuality) {
+            case NoiseQuality::QUALITY_FAST:
+                GradientCoherentNoise3D<NoiseQuality::QUALITY_FAST>(x, y, z, out, count, seed);
+                break;
+            case NoiseQuality::QUALITY_STD:
+                GradientCoherentNoise3D<NoiseQuality::QUALITY_STD>(x, y, z, out, count, seed);
+                break;
+            case NoiseQuality::QUALITY_BEST:
+            default:
+                GradientCoherentNoise3D<NoiseQuality::QUALITY_BEST>(x, y, z, out, count, seed);
+                break;
+        }
+    }
+
+    void GradientCoherentNoise3D(const float* x, const float* y, const float* z,
+        float* out, int count, int32 seed, NoiseQuality noiseQuality) noexcept {
+        switch (noiseQuality) {
+            case NoiseQuality::QUALITY_FAST:
+                GradientCoherentNoise3D<NoiseQuality::QUALITY_FAST>(x, y, z, out, count, seed);
+                break;
+            case NoiseQuality::QUALITY_STD:
+                GradientCoherentNoise3D<NoiseQuality::QUALITY_STD>(x, y, z, out, count, seed);
+                break;
+            case NoiseQuality::QUALITY_BEST:
+            default:
+                GradientCoherentNoise3D<NoiseQuality::QUALITY_BEST>(x, y, z, out, count, seed);
+                break;
+        }
+    }
+
+    template <NoiseQuality Q>
+    void GradientCoherentNoise2D(const double* x, const double* z,
+        double* out, int count, int32 seed) noexcept {
+        static const GradientBatchKernel2D<double> kernel = SelectGradientBatchKernel2D<double, Q>();
+        kernel(x, z, out, count, seed);
+    }
+
+    template <NoiseQuality Q>
+    void GradientCoherentNoise2D(const float* x, const float* z,
+        float* out, int count, int32 seed) noexcept {
+        static const GradientBatchKernel2D<float> kernel = SelectGradientBatchKernel2D<float, Q>();
+        kernel(x, z, out, count, seed);
+    }
+
+    template void GradientCoherentNoise2D<NoiseQuality::QUALITY_FAST>(const double*, const double*,
+        double*, int, int32) noexcept;
+    template void GradientCoherentNoise2D<NoiseQuality::QUALITY_STD>(const double*, const double*,
+        double*, int, int32) noexcept;
+    template void GradientCoherentNoise2D<NoiseQuality::QUALITY_BEST>(const double*, const double*,
+        double*, int, int32) noexcept;
+    template void GradientCoherentNoise2D<NoiseQuality::QUALITY_FAST>(const float*, const float*,
+        float*, int, int32) noexcept;
+    template void GradientCoherentNoise2D<NoiseQuality::QUALITY_STD>(const float*, const float*,
+        float*, int, int32) noexcept;
+    template void GradientCoherentNoise2D<NoiseQuality::QUALITY_BEST>(const float*, const float*,
+        float*, int, int32) noexcept;
+
     int32 IntValueNoise3D(int32 x, int32 y, int32 z, int32 seed) noexcept {
         // All constants are primes and must remain prime for this noise function to work correctly.
         int32 n = (
@@ -157,8 +1262,8 @@ namespace noise {
         return (n * (n * n * 60493 + 19990303) + 1376312589) & 0x7fffffff;
     }
 
-    double ValueCoherentNoise3D(double x, double y, double z, int32 seed,
-        NoiseQuality noiseQuality) noexcept {
+    template <NoiseQuality Q>
+    double ValueCoherentNoise3D(double x, double y, double z, int32 seed) noexcept {
         // Create a unit-length cube aligned along an integer boundary. This cube surrounds the input point.
         const int32 x0 = FastFloor(x);
         const int32 x1 = x0 + 1;
@@ -169,24 +1274,9 @@ namespace noise {
 
         // Map the difference between the coordinates of the input value and the
         // coordinates of the cube's outer-lower-left vertex onto an S-curve.
-        double xs = 0, ys = 0, zs = 0;
-        switch (noiseQuality) {
-            case NoiseQuality::QUALITY_FAST:
-                xs = (x - static_cast<double>(x0));
-                ys = (y - static_cast<double>(y0));
-                zs = (z - static_cast<double>(z0));
-                break;
-            case NoiseQuality::QUALITY_STD:
-                xs = SCurve3(x - static_cast<double>(x0));
-                ys = SCurve3(y - static_cast<double>(y0));
-                zs = SCurve3(z - static_cast<double>(z0));
-                break;
-            case NoiseQuality::QUALITY_BEST:
-                xs = SCurve5(x - static_cast<double>(x0));
-                ys = SCurve5(y - static_cast<double>(y0));
-                zs = SCurve5(z - static_cast<double>(z0));
-                break;
-        }
+        const double xs = SCurve<Q>(x - static_cast<double>(x0));
+        const double ys = SCurve<Q>(y - static_cast<double>(y0));
+        const double zs = SCurve<Q>(z - static_cast<double>(z0));
 
         // Calculate the noise values at each vertex of the cube and interpolate.
         double n0 = ValueNoise3D(x0, y0, z0, seed);
@@ -206,4 +1296,21 @@ namespace noise {
         return LinearInterp(iy0, iy1, zs);
     }
 
+    template double ValueCoherentNoise3D<NoiseQuality::QUALITY_FAST>(double, double, double, int32) noexcept;
+    template double ValueCoherentNoise3D<NoiseQuality::QUALITY_STD>(double, double, double, int32) noexcept;
+    template double ValueCoherentNoise3D<NoiseQuality::QUALITY_BEST>(double, double, double, int32) noexcept;
+
+    double ValueCoherentNoise3D(double x, double y, double z, int32 seed,
+        NoiseQuality noiseQuality) noexcept {
+        switch (noiseQuality) {
+            case NoiseQuality::QUALITY_FAST:
+                return ValueCoherentNoise3D<NoiseQuality::QUALITY_FAST>(x, y, z, seed);
+            case NoiseQuality::QUALITY_STD:
+                return ValueCoherentNoise3D<NoiseQuality::QUALITY_STD>(x, y, z, seed);
+            case NoiseQuality::QUALITY_BEST:
+            default:
+                return ValueCoherentNoise3D<NoiseQuality::QUALITY_BEST>(x, y, z, seed);
+        }
+    }
+
 } // namespace noise
\ No newline at end of file
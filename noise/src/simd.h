@@ -0,0 +1,77 @@
+// simd.h
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+
+#pragma once
+
+// Internal header shared by the source files that contain SIMD batch kernels.
+//
+// The kernels use x86 SIMD instructions that are selected at run time, so each
+// kernel is compiled for its own instruction set rather than for the
+// instruction set of the whole library.
+#if !defined(NOISE_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define NOISE_SIMD_X86 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define NOISE_TARGET_SSE41
+#define NOISE_TARGET_AVX2
+#else
+#include <immintrin.h>
+#define NOISE_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define NOISE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+#ifdef NOISE_SIMD_X86
+
+namespace noise {
+
+    namespace simd {
+
+        /// Returns true if the processor and the operating system support AVX2.
+        inline bool CpuSupportsAvx2() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7) {
+                return false;
+            }
+            __cpuid(info, 1);
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            const bool avx = (info[2] & (1 << 28)) != 0;
+            if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+                return false;
+            }
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+#endif
+        }
+
+        /// Returns true if the processor supports SSE4.1.
+        inline bool CpuSupportsSse41() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+            int info[4];
+            __cpuid(info, 1);
+            return (info[2] & (1 << 19)) != 0;
+#else
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse4.1");
+#endif
+        }
+
+    } // namespace simd
+
+} // namespace noise
+
+#endif // NOISE_SIMD_X86
@@ -45,6 +45,7 @@
 #include <vector>
 
 #include <noise/interp.h>
+#include <noise/latlon.h>
 #include <noise/mathconsts.h>
 #include <noise/model/cylinder.h>
 #include <noise/model/plane.h>
@@ -536,7 +537,9 @@ namespace noise {
             m_pCallback(nullptr),
             m_destHeight(0),
             m_destWidth(0),
-            m_pDestNoiseMap(nullptr) {
+            m_pDestNoiseMap(nullptr),
+            m_isSinglePrecisionEnabled(false),
+            m_isLevelOfDetailEnabled(false) {
         }
 
         void NoiseMapBuilder::SetDestSize(int destWidth, int destHeight) {
@@ -551,6 +554,24 @@ namespace noise {
             m_pCallback = pCallback;
         }
 
+        void NoiseMapBuilder::GetSourceValues(const noise::module::Module& sourceModule,
+            const double* x, const double* y, const double* z,
+            double* out, int count, double sampleSpacing, noise::module::EvalStats& stats) const {
+            noise::module::EvalContext context;
+            context.stats = &stats;
+            if (m_isLevelOfDetailEnabled) {
+                context.sampleSpacing = sampleSpacing;
+            }
+            if (!m_isSinglePrecisionEnabled) {
+                sourceModule.GetValues(context, x, y, z, out, count);
+                return;
+            }
+            std::vector<float> xs(x, x + count), ys(y, y + count), zs(z, z + count);
+            std::vector<float> values(count);
+            sourceModule.GetValues(context, xs.data(), ys.data(), zs.data(), values.data(), count);
+            std::copy(values.begin(), values.end(), out);
+        }
+
         //////////////////////////////////////////////////////////////////////////////
         // NoiseMapBuilderCylinder class
 
@@ -575,9 +596,6 @@ namespace noise {
             // values from the source model.
             m_pDestNoiseMap->SetSize(m_destWidth, m_destHeight);
 
-            // Create the cylinder model.
-            model::Cylinder cylinderModel(*m_sourceModules);
-
             double angleExtent = m_upperAngleBound - m_lowerAngleBound;
             double heightExtent = m_upperHeightBound - m_lowerHeightBound;
             double xDelta = angleExtent / static_cast<double>(m_destWidth);
@@ -585,15 +603,33 @@ namespace noise {
             double curAngle = m_lowerAngleBound;
             double curHeight = m_lowerHeightBound;
 
-            // Fill every point in the noise map with the output values from the model.
+            // Adjacent points lie one angle step apart on the unit circle and one
+            // height step apart along the axis.
+            const double sampleSpacing = std::max(xDelta * DEG_TO_RAD, yDelta);
+            m_evalStats = {};
+
+            // Input values and output values for one row of the noise map.  Each row
+            // is passed to the source module as a single batch.
+            std::vector<double> xRow(m_destWidth), yRow(m_destWidth), zRow(m_destWidth);
+            std::vector<double> valueRow(m_destWidth);
+
+            // Fill every point in the noise map with the output values from the
+            // surface of the cylinder (see noise::model::Cylinder).
             for (int y = 0; y < m_destHeight; y++) {
                 float* pDest = m_pDestNoiseMap->GetSlabPtr(0, y);
                 curAngle = m_lowerAngleBound;
                 for (int x = 0; x < m_destWidth; x++) {
-                    float curValue = static_cast<float>(cylinderModel.GetValue(curAngle, curHeight));
-                    *pDest++ = curValue;
+                    const double angleRad = curAngle * DEG_TO_RAD;
+                    xRow[x] = std::cos(angleRad);
+                    yRow[x] = curHeight;
+                    zRow[x] = std::sin(angleRad);
                     curAngle += xDelta;
                 }
+                GetSourceValues(*m_sourceModules, xRow.data(), yRow.data(), zRow.data(), valueRow.data(),
+                    m_destWidth, sampleSpacing, m_evalStats);
+                for (int x = 0; x < m_destWidth; x++) {
+                    *pDest++ = static_cast<float>(valueRow[x]);
+                }
                 curHeight += yDelta;
                 if (m_pCallback) {
                     m_pCallback(y);
@@ -638,37 +674,63 @@ namespace noise {
             // values from the source model.
             m_pDestNoiseMap->SetSize(m_destWidth, m_destHeight);
 
-            // Create the plane model.
-            model::Plane planeModel(*m_sourceModules);
-
             double xExtent = m_upperXBound - m_lowerXBound;
             double zExtent = m_upperZBound - m_lowerZBound;
             double xDelta = xExtent / static_cast<double>(m_destWidth);
             double zDelta = zExtent / static_cast<double>(m_destHeight);
             double xCur = m_lowerXBound;
             double zCur = m_lowerZBound;
+            const double sampleSpacing = std::max(xDelta, zDelta);
+            m_evalStats = {};
+
+            // Input values and output values for one row of the noise map.  Each row
+            // is passed to the source module as a single batch; the plane lies at
+            // y = 0 (see noise::model::Plane).  The seamless variant evaluates the
+            // row at the four tile offsets and blends the results.
+            std::vector<double> xRow(m_destWidth), yRow(m_destWidth, 0.0), zRow(m_destWidth);
+            std::vector<double> xOffsetRow, zOffsetRow;
+            std::vector<double> swRow(m_destWidth), seRow, nwRow, neRow;
+            if (m_isSeamlessEnabled) {
+                xOffsetRow.resize(m_destWidth);
+                zOffsetRow.resize(m_destWidth);
+                seRow.resize(m_destWidth);
+                nwRow.resize(m_destWidth);
+                neRow.resize(m_destWidth);
+            }
 
             // Fill every point in the noise map with the output values from the model.
             for (int z = 0; z < m_destHeight; z++) {
                 float* pDest = m_pDestNoiseMap->GetSlabPtr(0, z);
                 xCur = m_lowerXBound;
                 for (int x = 0; x < m_destWidth; x++) {
-                    float finalValue;
-                    if (!m_isSeamlessEnabled) {
-                        finalValue = planeModel.GetValue(xCur, zCur);
-                    } else {
-                        double swValue = planeModel.GetValue(xCur, zCur);
-                        double seValue = planeModel.GetValue(xCur + xExtent, zCur);
-                        double nwValue = planeModel.GetValue(xCur, zCur + zExtent);
-                        double neValue = planeModel.GetValue(xCur + xExtent, zCur + zExtent);
-                        double xBlend = 1.0 - ((xCur - m_lowerXBound) / xExtent);
+                    xRow[x] = xCur;
+                    zRow[x] = zCur;
+                    xCur += xDelta;
+                }
+                GetSourceValues(*m_sourceModules, xRow.data(), yRow.data(), zRow.data(), swRow.data(),
+                    m_destWidth, sampleSpacing, m_evalStats);
+                if (!m_isSeamlessEnabled) {
+                    for (int x = 0; x < m_destWidth; x++) {
+                        *pDest++ = static_cast<float>(swRow[x]);
+                    }
+                } else {
+                    for (int x = 0; x < m_destWidth; x++) {
+                        xOffsetRow[x] = xRow[x] + xExtent;
+                        zOffsetRow[x] = zCur + zExtent;
+                    }
+                    GetSourceValues(*m_sourceModules, xOffsetRow.data(), yRow.data(), zRow.data(), seRow.data(),
+                        m_destWidth, sampleSpacing, m_evalStats);
+                    GetSourceValues(*m_sourceModules, xRow.data(), yRow.data(), zOffsetRow.data(), nwRow.data(),
+                        m_destWidth, sampleSpacing, m_evalStats);
+                    GetSourceValues(*m_sourceModules, xOffsetRow.data(), yRow.data(), zOffsetRow.data(), neRow.data(),
+                        m_destWidth, sampleSpacing, m_evalStats);
+                    for (int x = 0; x < m_destWidth; x++) {
+                        double xBlend = 1.0 - ((xRow[x] - m_lowerXBound) / xExtent);
                         double zBlend = 1.0 - ((zCur - m_lowerZBound) / zExtent);
-                        double z0 = LinearInterp(swValue, seValue, xBlend);
-                        double z1 = LinearInterp(nwValue, neValue, xBlend);
-                        finalValue = static_cast<float>(LinearInterp(z0, z1, zBlend));
+                        double z0 = LinearInterp(swRow[x], seRow[x], xBlend);
+                        double z1 = LinearInterp(nwRow[x], neRow[x], xBlend);
+                        *pDest++ = static_cast<float>(LinearInterp(z0, z1, zBlend));
                     }
-                    *pDest++ = finalValue;
-                    xCur += xDelta;
                 }
                 zCur += zDelta;
                 if (m_pCallback) {
@@ -713,9 +775,6 @@ namespace noise {
             // values from the source model.
             m_pDestNoiseMap->SetSize(m_destWidth, m_destHeight);
 
-            // Create the sphere model.
-            model::Sphere sphereModel(*m_sourceModules);
-
             double lonExtent = m_eastLonBound - m_westLonBound;
             double latExtent = m_northLatBound - m_southLatBound;
             double xDelta = lonExtent / static_cast<double>(m_destWidth);
@@ -726,8 +785,16 @@ namespace noise {
             if (numThreads == 0) numThreads = 4; // Fallback to 4 threads if hardware concurrency is unavailable
             numThreads = std::min(numThreads, static_cast<unsigned int>(m_destHeight)); // Don't use more threads than rows
 
-            // Divide rows among threads
+            // Divide rows among threads.  Each thread evaluates its own copy of the
+            // source-module graph and records its own statistics, so the threads
+            // share no state.  The copies are made here, as an exception thrown by
+            // a thread could not be passed on to the caller.
             std::vector<std::thread> threads;
+            std::vector<noise::module::EvalStats> threadStats(numThreads);
+            std::vector<noise::module::GraphReplica> replicas(numThreads);
+            for (auto& replica : replicas) {
+                replica.Replicate(*m_sourceModules);
+            }
             int rowsPerThread = m_destHeight / numThreads;
             int remainingRows = m_destHeight % numThreads;
             int startRow = 0;
@@ -737,16 +804,32 @@ namespace noise {
                 if (rowCount == 0) break; // Skip empty threads if height is less than numThreads
 
                 int endRow = startRow + rowCount;
-                threads.emplace_back([this, startRow, endRow, xDelta, yDelta, lonExtent, latExtent, &sphereModel]() {
+                noise::module::EvalStats& stats = threadStats[t];
+                const noise::module::Module& sourceModule = replicas[t].GetRoot();
+                threads.emplace_back([this, &stats, &sourceModule, startRow, endRow, xDelta, yDelta, lonExtent, latExtent]() {
+                    // Input values and output values for one row of the noise map.  Each
+                    // row is passed to the source module as a single batch of points on
+                    // the surface of the unit sphere (see noise::model::Sphere).
+                    std::vector<double> xRow(m_destWidth), yRow(m_destWidth), zRow(m_destWidth);
+                    std::vector<double> valueRow(m_destWidth);
+
                     double curLat = m_southLatBound + (startRow * latExtent / static_cast<double>(m_destHeight));
                     for (int y = startRow; y < endRow; y++) {
                         float* pDest = m_pDestNoiseMap->GetSlabPtr(0, y);
                         double curLon = m_westLonBound;
                         for (int x = 0; x < m_destWidth; x++) {
-                            float curValue = static_cast<float>(sphereModel.GetValue(curLat, curLon));
-                            *pDest++ = curValue;
+                            LatLonToXYZ(curLat, curLon, xRow[x], yRow[x], zRow[x]);
                             curLon += xDelta;
                         }
+                        // Adjacent points lie one latitude step apart, and one longitude
+                        // step (shrinking toward the poles) apart along the row.
+                        const double sampleSpacing = std::max(yDelta * DEG_TO_RAD,
+                            xDelta * DEG_TO_RAD * std::cos(curLat * DEG_TO_RAD));
+                        GetSourceValues(sourceModule, xRow.data(), yRow.data(), zRow.data(), valueRow.data(),
+                            m_destWidth, sampleSpacing, stats);
+                        for (int x = 0; x < m_destWidth; x++) {
+                            *pDest++ = static_cast<float>(valueRow[x]);
+                        }
                         curLat += yDelta;
                         if (m_pCallback) {
                             m_pCallback(y);
@@ -760,6 +843,10 @@ namespace noise {
             for (auto& thread : threads) {
                 thread.join();
             }
+            m_evalStats = {};
+            for (const auto& stats : threadStats) {
+                m_evalStats += stats;
+            }
         }
 
         void NoiseMapBuilderSphere::SetBounds(double southLatBound, double northLatBound,
@@ -725,6 +725,12 @@ namespace noise {
 		/// - Pass a noise module (derived from noise::module::Module) to the
 		///   SetSourceModule() method.
 		/// - Call the Build() method.
+		///
+		/// Each row of the noise map is evaluated with one call to the source
+		/// module's GetValues() (see noise::module::Module::GetValues()).  A noise
+		/// module that is shared by several others in the source graph should be
+		/// connected through a noise::module::Cache module, so that a row evaluates
+		/// it once per input value, as the per-point GetValue() path does.
 		class NoiseMapBuilder {
 		public:
 			/// Constructor.
@@ -743,6 +749,34 @@ namespace noise {
 			/// coherent-noise values generated from the source module.
 			virtual void Build() = 0;
 
+			/// Enables or disables single-precision evaluation of the source module.
+			///
+			/// @param enable Specifies whether to enable single-precision evaluation.
+			///
+			/// When enabled, the Build() method evaluates each row of the noise map
+			/// with the single-precision overload of noise::module::Module::GetValues().
+			/// The noise map stores single-precision values, so the result is close to
+			/// the double-precision result while the generator modules process twice as
+			/// many values per SIMD instruction.  Disabled by default.
+			void EnableSinglePrecision(bool enable = true) noexcept {
+				m_isSinglePrecisionEnabled = enable;
+			}
+
+			/// Enables or disables level-of-detail evaluation of the source module.
+			///
+			/// @param enable Specifies whether to enable level-of-detail evaluation.
+			///
+			/// When enabled, the Build() method passes the distance between adjacent
+			/// points of the noise map to the source module as the sample spacing of
+			/// a noise::module::EvalContext.  The fractal generator modules then fade
+			/// out and skip the octaves whose features are too small to be resolved
+			/// at that spacing, so the noise map is smoother and is built faster when
+			/// the source module has many octaves.  Disabled by default, as the output
+			/// values differ from the output values without level of detail.
+			void EnableLevelOfDetail(bool enable = true) noexcept {
+				m_isLevelOfDetailEnabled = enable;
+			}
+
 			/// Returns the height of the destination noise map.
 			///
 			/// @returns The height of the destination noise map, in points.
@@ -761,6 +795,37 @@ namespace noise {
 				return m_destWidth;
 			}
 
+			/// Determines if single-precision evaluation is enabled.
+			///
+			/// @returns
+			/// - @a true if single-precision evaluation is enabled.
+			/// - @a false if single-precision evaluation is disabled.
+			[[nodiscard]] bool IsSinglePrecisionEnabled() const noexcept {
+				return m_isSinglePrecisionEnabled;
+			}
+
+			/// Determines if level-of-detail evaluation is enabled.
+			///
+			/// @returns
+			/// - @a true if level-of-detail evaluation is enabled.
+			/// - @a false if level-of-detail evaluation is disabled.
+			[[nodiscard]] bool IsLevelOfDetailEnabled() const noexcept {
+				return m_isLevelOfDetailEnabled;
+			}
+
+			/// Returns the statistics that the source module recorded during the
+			/// last call to the Build() method.
+			///
+			/// @returns The cache hits, cache misses and noise octaves counted while
+			/// the noise map was built.
+			///
+			/// Each thread that Build() starts records its own statistics through a
+			/// noise::module::EvalContext; they are added together once every thread
+			/// has finished.
+			[[nodiscard]] const noise::module::EvalStats& GetEvalStats() const noexcept {
+				return m_evalStats;
+			}
+
 			/// Sets the callback function that Build() calls each time it fills a row
 			/// of the noise map.
 			///
@@ -804,6 +869,25 @@ namespace noise {
 			void SetDestSize(int destWidth, int destHeight);
 
 		protected:
+			/// Evaluates the source module for one row of input values.
+			///
+			/// @param sourceModule The source module, or the calling thread's copy
+			/// of it.
+			/// @param x Array containing the x-coordinates of the input values.
+			/// @param y Array containing the y-coordinates of the input values.
+			/// @param z Array containing the z-coordinates of the input values.
+			/// @param[out] out Array that receives the output values.
+			/// @param count The number of input values.
+			/// @param sampleSpacing The distance between adjacent input values.
+			/// @param stats The statistics of the calling thread.
+			///
+			/// Uses the single-precision overload of GetValues() if single-precision
+			/// evaluation is enabled, and passes the sample spacing to the source
+			/// module if level-of-detail evaluation is enabled.
+			void GetSourceValues(const noise::module::Module& sourceModule,
+				const double* x, const double* y, const double* z,
+				double* out, int count, double sampleSpacing, noise::module::EvalStats& stats) const;
+
 			/// The callback function that Build() calls each time it fills a row of
 			/// the noise map.
 			NoiseMapCallback m_pCallback{};
@@ -819,6 +903,15 @@ namespace noise {
 
 			/// The source noise module that will generate the coherent-noise values.
 			const noise::module::Module* m_sourceModules{};
+
+			/// Determines if single-precision evaluation is enabled.
+			bool m_isSinglePrecisionEnabled{};
+
+			/// Determines if level-of-detail evaluation is enabled.
+			bool m_isLevelOfDetailEnabled{};
+
+			/// The statistics recorded during the last call to Build().
+			noise::module::EvalStats m_evalStats{};
 		};
 
 		/// Builds a cylindrical noise map.
@@ -1022,6 +1115,12 @@ namespace noise {
 		///
 		/// The application must also specify the southern, northern, western, and
 		/// eastern bounds of the noise map, in degrees.
+		///
+		/// The Build() method fills the rows of the noise map on several threads.
+		/// Each thread evaluates its own copy of the source-module graph (see
+		/// noise::module::GraphReplica), so the graph may contain noise modules
+		/// that keep mutable state, provided that they override
+		/// noise::module::Module::Clone().
 		class NoiseMapBuilderSphere : public NoiseMapBuilder {
 		public:
 			/// Constructor.
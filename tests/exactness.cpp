@@ -0,0 +1,578 @@
+// exactness.cpp
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// Checks that the optimized evaluation paths of libnoise return exactly the
+// values of their reference implementations: the SIMD batch kernels and the
+// batch GetValues() methods against the single-point functions, the planar
+// gradient-noise path against the three-dimensional one, the pruned Voronoi
+// search and the Curve and Terrace segment search against the original
+// algorithms, and CompiledGraph against the noise-module graph it compiles.
+// Values are compared bit for bit. Returns a nonzero exit code if any check
+// fails.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <noise/noise.h>
+
+using namespace noise;
+
+namespace {
+
+    // Number of checks that failed.
+    int g_failureCount = 0;
+
+    // Input values of one kind of batch.
+    struct Points {
+        std::string name;
+        std::vector<double> x, y, z;
+    };
+
+    // Returns true if two values have the same bit pattern.
+    template <typename Real>
+    bool IsSame(Real a, Real b) {
+        return std::memcmp(&a, &b, sizeof(Real)) == 0;
+    }
+
+    // Compares the values of a batch path with the values of its reference and
+    // reports the first difference.
+    template <typename Real>
+    void Check(const std::string& name, const std::vector<Real>& expected, const std::vector<Real>& actual) {
+        int differenceCount = 0;
+        size_t first = 0;
+        for (size_t i = 0; i < expected.size(); ++i) {
+            if (!IsSame(expected[i], actual[i])) {
+                if (differenceCount++ == 0) {
+                    first = i;
+                }
+            }
+        }
+        if (differenceCount == 0) {
+            std::printf("PASS %s\n", name.c_str());
+            return;
+        }
+        ++g_failureCount;
+        std::printf("FAIL %s: %d of %zu values differ (first at %zu: expected %.17g, got %.17g)\n",
+            name.c_str(), differenceCount, expected.size(), first,
+            static_cast<double>(expected[first]), static_cast<double>(actual[first]));
+    }
+
+    // Returns the kinds of batches that the optimized paths treat differently:
+    // scattered input values, rows of a noise map on the plane y = 0, and rows
+    // of closely spaced input values that share lattice cells.
+    std::vector<Points> MakePoints() {
+        std::vector<Points> sets;
+        std::mt19937 random(12345);
+
+        Points scattered{ "scattered" };
+        std::uniform_real_distribution<double> near(-8.0, 8.0);
+        std::uniform_real_distribution<double> far(-2.0e6, 2.0e6);
+        for (int i = 0; i < 1000; ++i) {
+            std::uniform_real_distribution<double>& range = (i % 4 == 3) ? far : near;
+            scattered.x.push_back(range(random));
+            scattered.y.push_back(range(random));
+            scattered.z.push_back(range(random));
+        }
+        // Integer coordinates put an input value on a lattice vertex.
+        for (int i = 0; i < 27; ++i) {
+            scattered.x.push_back(i % 3 - 1.0);
+            scattered.y.push_back((i / 3) % 3 - 1.0);
+            scattered.z.push_back(i / 9 - 1.0);
+        }
+        sets.push_back(scattered);
+
+        Points plane{ "plane" };
+        for (int row = 0; row < 8; ++row) {
+            for (int column = 0; column < 300; ++column) {
+                plane.x.push_back(-2.0 + column * (4.0 / 300.0));
+                plane.y.push_back(0.0);
+                plane.z.push_back(-1.0 + row * 0.37);
+            }
+        }
+        sets.push_back(plane);
+
+        Points row{ "row" };
+        for (int column = 0; column < 1000; ++column) {
+            row.x.push_back(3.25 + column * 0.002);
+            row.y.push_back(0.3);
+            row.z.push_back(-1.7);
+        }
+        sets.push_back(row);
+        return sets;
+    }
+
+    // Evaluates a noise module one input value at a time.
+    std::vector<double> GetScalarValues(const module::Module& module, const Points& points) {
+        std::vector<double> values(points.x.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            values[i] = module.GetValue(points.x[i], points.y[i], points.z[i]);
+        }
+        return values;
+    }
+
+    // Evaluates a noise module in one batch.
+    std::vector<double> GetBatchValues(const module::Module& module, const Points& points) {
+        std::vector<double> values(points.x.size());
+        module.GetValues(points.x.data(), points.y.data(), points.z.data(), values.data(),
+            static_cast<int>(values.size()));
+        return values;
+    }
+
+    // Evaluates a noise module in one single-precision batch, or one input value
+    // at a time if count is 1.
+    std::vector<float> GetFloatValues(const module::Module& module, const Points& points, int count) {
+        const size_t size = points.x.size();
+        std::vector<float> x(points.x.begin(), points.x.end());
+        std::vector<float> y(points.y.begin(), points.y.end());
+        std::vector<float> z(points.z.begin(), points.z.end());
+        std::vector<float> values(size);
+        for (size_t start = 0; start < size; start += static_cast<size_t>(count)) {
+            const int blockCount = static_cast<int>(std::min(size - start, static_cast<size_t>(count)));
+            module.GetValues(x.data() + start, y.data() + start, z.data() + start,
+                values.data() + start, blockCount);
+        }
+        return values;
+    }
+
+    // Checks the batch paths of a noise module against its single-point path:
+    // the double-precision batch against GetValue(), and the single-precision
+    // batch against the same single-precision path run one value at a time.
+    void CheckBatchPaths(const std::string& name, const module::Module& module,
+        const std::vector<Points>& sets) {
+        for (const Points& points : sets) {
+            Check(name + " batch, " + points.name, GetScalarValues(module, points), GetBatchValues(module, points));
+            const int size = static_cast<int>(points.x.size());
+            Check(name + " float batch, " + points.name, GetFloatValues(module, points, 1),
+                GetFloatValues(module, points, size));
+        }
+    }
+
+    // The original Perlin octave loop, which evaluates three-dimensional
+    // gradient noise for every octave.
+    double ReferencePerlin(const module::Perlin& perlin, double x, double y, double z) {
+        double value = 0.0;
+        double curPersistence = 1.0;
+        x *= perlin.GetFrequency();
+        y *= perlin.GetFrequency();
+        z *= perlin.GetFrequency();
+        for (int curOctave = 0; curOctave < perlin.GetOctaveCount(); ++curOctave) {
+            const int32 seed = (perlin.GetSeed() + curOctave) & 0xffffffff;
+            const double signal = GradientCoherentNoise3D(MakeInt32Range(x), MakeInt32Range(y),
+                MakeInt32Range(z), seed, perlin.GetNoiseQuality());
+            value += signal * curPersistence;
+            x *= perlin.GetLacunarity();
+            y *= perlin.GetLacunarity();
+            z *= perlin.GetLacunarity();
+            curPersistence *= perlin.GetPersistence();
+        }
+        return value;
+    }
+
+    // The original Billow octave loop.
+    double ReferenceBillow(const module::Billow& billow, double x, double y, double z) {
+        double value = 0.0;
+        double curPersistence = 1.0;
+        x *= billow.GetFrequency();
+        y *= billow.GetFrequency();
+        z *= billow.GetFrequency();
+        for (int curOctave = 0; curOctave < billow.GetOctaveCount(); ++curOctave) {
+            const int32 seed = (billow.GetSeed() + curOctave) & 0xffffffff;
+            double signal = GradientCoherentNoise3D(MakeInt32Range(x), MakeInt32Range(y),
+                MakeInt32Range(z), seed, billow.GetNoiseQuality());
+            signal = 2.0 * std::abs(signal) - 1.0;
+            value += signal * curPersistence;
+            x *= billow.GetLacunarity();
+            y *= billow.GetLacunarity();
+            z *= billow.GetLacunarity();
+            curPersistence *= billow.GetPersistence();
+        }
+        return value + 0.5;
+    }
+
+    // The original Voronoi search over all 125 cells around the input value.
+    double ReferenceVoronoi(const module::Voronoi& voronoi, double x, double y, double z) {
+        x *= voronoi.GetFrequency();
+        y *= voronoi.GetFrequency();
+        z *= voronoi.GetFrequency();
+        const int xInt = (x > 0.0 ? static_cast<int>(x) : static_cast<int>(x) - 1);
+        const int yInt = (y > 0.0 ? static_cast<int>(y) : static_cast<int>(y) - 1);
+        const int zInt = (z > 0.0 ? static_cast<int>(z) : static_cast<int>(z) - 1);
+
+        double minDist = std::numeric_limits<double>::max();
+        double xCandidate = 0.0;
+        double yCandidate = 0.0;
+        double zCandidate = 0.0;
+        const int seed = voronoi.GetSeed();
+        for (int zCur = zInt - 2; zCur <= zInt + 2; zCur++) {
+            for (int yCur = yInt - 2; yCur <= yInt + 2; yCur++) {
+                for (int xCur = xInt - 2; xCur <= xInt + 2; xCur++) {
+                    const double xPos = xCur + ValueNoise3D(xCur, yCur, zCur, seed);
+                    const double yPos = yCur + ValueNoise3D(xCur, yCur, zCur, seed + 1);
+                    const double zPos = zCur + ValueNoise3D(xCur, yCur, zCur, seed + 2);
+                    const double xDist = xPos - x;
+                    const double yDist = yPos - y;
+                    const double zDist = zPos - z;
+                    const double dist = xDist * xDist + yDist * yDist + zDist * zDist;
+                    if (dist < minDist) {
+                        minDist = dist;
+                        xCandidate = xPos;
+                        yCandidate = yPos;
+                        zCandidate = zPos;
+                    }
+                }
+            }
+        }
+
+        double value = 0.0;
+        if (voronoi.IsDistanceEnabled()) {
+            const double xDist = xCandidate - x;
+            const double yDist = yCandidate - y;
+            const double zDist = zCandidate - z;
+            value = std::sqrt(xDist * xDist + yDist * yDist + zDist * zDist) * SQRT_3 - 1.0;
+        }
+        return value + (voronoi.GetDisplacement() * ValueNoise3D(
+            static_cast<int>(std::floor(xCandidate)),
+            static_cast<int>(std::floor(yCandidate)),
+            static_cast<int>(std::floor(zCandidate))));
+    }
+
+    // The original Curve mapping, which scans the control points linearly.
+    double ReferenceCurve(const module::Curve& curve, double sourceValue) {
+        const module::ControlPoint* points = curve.GetControlPointArray();
+        const int count = curve.GetControlPointCount();
+        int indexPos;
+        for (indexPos = 0; indexPos < count; ++indexPos) {
+            if (sourceValue < points[indexPos].inputValue) {
+                break;
+            }
+        }
+        const int index0 = std::clamp(indexPos - 2, 0, count - 1);
+        const int index1 = std::clamp(indexPos - 1, 0, count - 1);
+        const int index2 = std::clamp(indexPos, 0, count - 1);
+        const int index3 = std::clamp(indexPos + 1, 0, count - 1);
+        if (index1 == index2) {
+            return points[index1].outputValue;
+        }
+        const double input0 = points[index1].inputValue;
+        const double input1 = points[index2].inputValue;
+        const double alpha = (sourceValue - input0) / (input1 - input0);
+        return CubicInterp(points[index0].outputValue, points[index1].outputValue,
+            points[index2].outputValue, points[index3].outputValue, alpha);
+    }
+
+    // The original Terrace mapping, which scans the control points linearly.
+    double ReferenceTerrace(const module::Terrace& terrace, double sourceValue) {
+        const double* points = terrace.GetControlPointArray();
+        const int count = terrace.GetControlPointCount();
+        int indexPos;
+        for (indexPos = 0; indexPos < count; indexPos++) {
+            if (sourceValue < points[indexPos]) {
+                break;
+            }
+        }
+        const int index0 = std::max(indexPos - 1, 0);
+        const int index1 = std::min(indexPos, count - 1);
+        if (index0 == index1) {
+            return points[index1];
+        }
+        double value0 = points[index0];
+        double value1 = points[index1];
+        double alpha = (sourceValue - value0) / (value1 - value0);
+        if (terrace.IsTerracesInverted()) {
+            alpha = 1.0 - alpha;
+            std::swap(value0, value1);
+        }
+        alpha *= alpha;
+        return LinearInterp(value0, value1, alpha);
+    }
+
+    // Evaluates a reference function at each input value.
+    std::vector<double> GetReferenceValues(const Points& points,
+        const std::function<double(double, double, double)>& reference) {
+        std::vector<double> values(points.x.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            values[i] = reference(points.x[i], points.y[i], points.z[i]);
+        }
+        return values;
+    }
+
+    // The batch gradient-noise kernels (SIMD where the processor supports it,
+    // including the reuse of lattice cells) against the single-point function,
+    // and the planar kernels against the three-dimensional function.
+    void CheckGradientNoise(const std::vector<Points>& sets) {
+        const NoiseQuality qualities[] = { NoiseQuality::QUALITY_FAST, NoiseQuality::QUALITY_STD,
+            NoiseQuality::QUALITY_BEST };
+        for (const NoiseQuality quality : qualities) {
+            const std::string suffix = " (quality " + std::to_string(static_cast<int>(quality)) + "), ";
+            for (const Points& points : sets) {
+                const size_t size = points.x.size();
+                std::vector<double> x(size), y(size), z(size);
+                for (size_t i = 0; i < size; ++i) {
+                    x[i] = MakeInt32Range(points.x[i] * 7.3);
+                    y[i] = MakeInt32Range(points.y[i] * 7.3);
+                    z[i] = MakeInt32Range(points.z[i] * 7.3);
+                }
+                std::vector<double> expected(size), actual(size);
+                for (size_t i = 0; i < size; ++i) {
+                    expected[i] = GradientCoherentNoise3D(x[i], y[i], z[i], 17, quality);
+                }
+                GradientCoherentNoise3D(x.data(), y.data(), z.data(), actual.data(),
+                    static_cast<int>(size), 17, quality);
+                Check("GradientCoherentNoise3D batch" + suffix + points.name, expected, actual);
+
+                std::vector<float> fx(x.begin(), x.end()), fy(y.begin(), y.end()), fz(z.begin(), z.end());
+                std::vector<float> floatExpected(size), floatActual(size);
+                for (size_t i = 0; i < size; ++i) {
+                    GradientCoherentNoise3D(&fx[i], &fy[i], &fz[i], &floatExpected[i], 1, 17, quality);
+                }
+                GradientCoherentNoise3D(fx.data(), fy.data(), fz.data(), floatActual.data(),
+                    static_cast<int>(size), 17, quality);
+                Check("GradientCoherentNoise3D float batch" + suffix + points.name, floatExpected, floatActual);
+            }
+        }
+
+        // The planar functions match the three-dimensional function on y = 0,
+        // except for the sign of a zero result.
+        const Points& plane = sets[1];
+        const size_t size = plane.x.size();
+        std::vector<double> x(size), z(size);
+        for (size_t i = 0; i < size; ++i) {
+            x[i] = plane.x[i] * 5.1;
+            z[i] = plane.z[i] * 5.1;
+        }
+        std::vector<double> expected(size), planar(size), actual(size);
+        for (size_t i = 0; i < size; ++i) {
+            expected[i] = GradientCoherentNoise3D(x[i], 0.0, z[i], 5);
+            planar[i] = GradientCoherentNoise2D(x[i], z[i], 5);
+            if (planar[i] == expected[i]) {
+                planar[i] = expected[i];
+            }
+        }
+        Check("GradientCoherentNoise2D, plane", expected, planar);
+        for (size_t i = 0; i < size; ++i) {
+            expected[i] = GradientCoherentNoise2D(x[i], z[i], 5);
+        }
+        GradientCoherentNoise2D<NoiseQuality::QUALITY_STD>(x.data(), z.data(), actual.data(),
+            static_cast<int>(size), 5);
+        Check("GradientCoherentNoise2D batch, plane", expected, actual);
+    }
+
+    // The fractal generators against the original octave loops (which use the
+    // three-dimensional noise on the plane y = 0 too), and their batch paths
+    // against their single-point paths.
+    void CheckGenerators(const std::vector<Points>& sets) {
+        module::Perlin perlin;
+        perlin.SetOctaveCount(8);
+        perlin.SetSeed(3);
+        module::Billow billow;
+        billow.SetNoiseQuality(NoiseQuality::QUALITY_BEST);
+        billow.SetFrequency(1.7);
+        module::RidgedMulti ridged;
+        ridged.SetOctaveCount(10);
+
+        for (const Points& points : sets) {
+            Check("Perlin reference, " + points.name,
+                GetReferenceValues(points, [&](double x, double y, double z) { return ReferencePerlin(perlin, x, y, z); }),
+                GetBatchValues(perlin, points));
+            Check("Billow reference, " + points.name,
+                GetReferenceValues(points, [&](double x, double y, double z) { return ReferenceBillow(billow, x, y, z); }),
+                GetBatchValues(billow, points));
+        }
+        CheckBatchPaths("Perlin", perlin, sets);
+        CheckBatchPaths("Billow", billow, sets);
+        CheckBatchPaths("RidgedMulti", ridged, sets);
+    }
+
+    // The pruned Voronoi search and its batch kernel against the full search.
+    void CheckVoronoi(const std::vector<Points>& sets) {
+        module::Voronoi voronoi;
+        module::Voronoi distance;
+        distance.EnableDistance(true);
+        distance.SetFrequency(2.5);
+        distance.SetSeed(11);
+        for (const module::Voronoi* module : { &voronoi, &distance }) {
+            const std::string name = module->IsDistanceEnabled() ? "Voronoi with distance" : "Voronoi";
+            for (const Points& points : sets) {
+                const std::vector<double> expected = GetReferenceValues(points,
+                    [&](double x, double y, double z) { return ReferenceVoronoi(*module, x, y, z); });
+                Check(name + " reference, " + points.name, expected, GetScalarValues(*module, points));
+                Check(name + " batch, " + points.name, expected, GetBatchValues(*module, points));
+            }
+        }
+    }
+
+    // The Curve and Terrace segment search against the linear scan.
+    void CheckCurveAndTerrace(const std::vector<Points>& sets) {
+        module::Perlin source;
+        source.SetFrequency(0.8);
+
+        module::Curve curve;
+        curve.SetSourceModule(0, source);
+        for (int i = 0; i < 40; ++i) {
+            curve.AddControlPoint(-1.2 + i * 0.06, std::sin(i * 0.7));
+        }
+        module::Terrace terrace;
+        terrace.SetSourceModule(0, source);
+        terrace.MakeControlPoints(9);
+        module::Terrace inverted;
+        inverted.SetSourceModule(0, source);
+        inverted.AddControlPoint(-0.8);
+        inverted.AddControlPoint(-0.1);
+        inverted.AddControlPoint(0.05);
+        inverted.AddControlPoint(0.6);
+        inverted.InvertTerraces(true);
+
+        for (const Points& points : sets) {
+            const std::vector<double> sourceValues = GetScalarValues(source, points);
+            std::vector<double> expected(sourceValues.size());
+            std::transform(sourceValues.begin(), sourceValues.end(), expected.begin(),
+                [&](double value) { return ReferenceCurve(curve, value); });
+            Check("Curve reference, " + points.name, expected, GetBatchValues(curve, points));
+            std::transform(sourceValues.begin(), sourceValues.end(), expected.begin(),
+                [&](double value) { return ReferenceTerrace(terrace, value); });
+            Check("Terrace reference, " + points.name, expected, GetBatchValues(terrace, points));
+            std::transform(sourceValues.begin(), sourceValues.end(), expected.begin(),
+                [&](double value) { return ReferenceTerrace(inverted, value); });
+            Check("inverted Terrace reference, " + points.name, expected, GetBatchValues(inverted, points));
+        }
+        CheckBatchPaths("Curve", curve, sets);
+        CheckBatchPaths("Terrace", terrace, sets);
+    }
+
+    // Select and Blend, which evaluate their source modules only for the input
+    // values that need them, against their single-point paths, and a compiled
+    // graph that uses every kind of instruction against the graph itself.
+    void CheckSelectBlendAndCompiledGraph(const std::vector<Points>& sets) {
+        module::Perlin perlin;
+        perlin.SetSeed(1);
+        module::Billow billow;
+        billow.SetSeed(2);
+        module::RidgedMulti ridged;
+        module::Voronoi voronoi;
+        voronoi.EnableDistance(true);
+        module::Cache cache;
+        cache.SetSourceModule(0, perlin);
+
+        // A source module that only the Select module uses, which CompiledGraph
+        // compiles into a separate program.
+        module::Perlin privatePerlin;
+        privatePerlin.SetSeed(4);
+        module::ScaleBias privateSource;
+        privateSource.SetSourceModule(0, privatePerlin);
+        privateSource.SetScale(0.5);
+        privateSource.SetBias(0.25);
+
+        module::Select select;
+        select.SetSourceModule(0, privateSource);
+        select.SetSourceModule(1, ridged);
+        select.SetControlModule(cache);
+        select.SetBounds(-0.2, 0.3);
+        select.SetEdgeFalloff(0.15);
+        module::Select hardSelect;
+        hardSelect.SetSourceModule(0, voronoi);
+        hardSelect.SetSourceModule(1, cache);
+        hardSelect.SetControlModule(billow);
+        hardSelect.SetBounds(0.0, 10.0);
+
+        // The clamped control module gives one source module the full weight
+        // at many input values.
+        module::Clamp control;
+        control.SetSourceModule(0, ridged);
+        control.SetBounds(-1.0, 1.0);
+        module::ScaleBias steepControl;
+        steepControl.SetSourceModule(0, cache);
+        steepControl.SetScale(4.0);
+        module::Clamp clampedControl;
+        clampedControl.SetSourceModule(0, steepControl);
+        clampedControl.SetBounds(-1.0, 1.0);
+        module::Blend blend;
+        blend.SetSourceModule(0, select);
+        blend.SetSourceModule(1, hardSelect);
+        blend.SetControlModule(clampedControl);
+
+        module::Curve curve;
+        curve.SetSourceModule(0, blend);
+        curve.AddControlPoint(-2.0, -1.0);
+        curve.AddControlPoint(-0.5, 0.2);
+        curve.AddControlPoint(0.3, -0.3);
+        curve.AddControlPoint(2.0, 1.0);
+        module::Terrace terrace;
+        terrace.SetSourceModule(0, cache);
+        terrace.MakeControlPoints(5);
+        module::ScalePoint scale;
+        scale.SetSourceModule(0, terrace);
+        scale.SetScale(1.5, 0.5, 2.0);
+        module::TranslatePoint translate;
+        translate.SetSourceModule(0, scale);
+        translate.SetTranslation(0.25, -1.0, 3.0);
+        module::Turbulence turbulence;
+        turbulence.SetSourceModule(0, curve);
+        turbulence.SetPower(0.1);
+        module::Add add;
+        add.SetSourceModule(0, turbulence);
+        add.SetSourceModule(1, translate);
+        module::Max max;
+        max.SetSourceModule(0, add);
+        max.SetSourceModule(1, control);
+
+        CheckBatchPaths("Select", select, sets);
+        CheckBatchPaths("Select without edge falloff", hardSelect, sets);
+        CheckBatchPaths("Blend", blend, sets);
+
+        for (const module::Module* root : { static_cast<const module::Module*>(&select),
+            static_cast<const module::Module*>(&blend), static_cast<const module::Module*>(&max) }) {
+            const module::CompiledGraph compiled(*root);
+            for (const Points& points : sets) {
+                const std::vector<double> expected = GetBatchValues(*root, points);
+                const std::string name = "CompiledGraph (" + std::to_string(compiled.GetInstructionCount())
+                    + " instructions), " + points.name;
+                Check(name, expected, GetBatchValues(compiled, points));
+                Check(name + ", single points", expected, GetScalarValues(compiled, points));
+
+                // The single-precision path of a compiled graph evaluates the
+                // double-precision program and rounds its output values.
+                Points floatPoints = points;
+                for (size_t i = 0; i < points.x.size(); ++i) {
+                    floatPoints.x[i] = static_cast<float>(points.x[i]);
+                    floatPoints.y[i] = static_cast<float>(points.y[i]);
+                    floatPoints.z[i] = static_cast<float>(points.z[i]);
+                }
+                const std::vector<double> floatExpected = GetBatchValues(*root, floatPoints);
+                Check(name + ", float", std::vector<float>(floatExpected.begin(), floatExpected.end()),
+                    GetFloatValues(compiled, points, static_cast<int>(points.x.size())));
+            }
+        }
+    }
+
+}
+
+int main() {
+    const std::vector<Points> sets = MakePoints();
+    CheckGradientNoise(sets);
+    CheckGenerators(sets);
+    CheckVoronoi(sets);
+    CheckCurveAndTerrace(sets);
+    CheckSelectBlendAndCompiledGraph(sets);
+    if (g_failureCount > 0) {
+        std::printf("%d checks failed\n", g_failureCount);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}